@@ -0,0 +1,47 @@
+#include "../src/srt/srt.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../example/scene_builder.hpp"
+#include "../src/srt/Camera.hpp"
+
+/**************************************** TYPEDEF ****************************************/
+
+/// A scene of the scene builder, with the camera used to render it by the examples.
+typedef struct bs{
+    std::string name;
+    std::function<Scene(const float, const float)> build;
+    float width, height;
+    Vec3 lookFrom, lookAt;
+    float vfov;
+    bool sky;
+} bench_scene;
+
+/**************************************** FUNCTIONS ****************************************/
+
+/**
+ * @brief Returns the scenes of the scene builder that are benchmarked, at the resolution of the examples.
+ *
+ * @return const std::vector<bench_scene>& - The scenes.
+ */
+const std::vector<bench_scene>& bench_scenes(){
+    static const std::vector<bench_scene> scenes{
+        {"random_scene", [](const float w, const float h){ return random_scene(w, h); }, 512, 384, {13, 2, 3}, {0, 0, 0}, 40, true},
+        {"cornell_box", cornell_box, 580, 720, {278, 278, -800}, {278, 278, 0}, 40, false},
+        {"my_random_scene", [](const float w, const float h){ return my_random_scene(w, h, 1000); }, 512, 384, {560, 850, -1050}, {560, 250, 0}, 40, true},
+        {"BVH_scene", BVH_scene, 512, 384, {0, 150, -600}, {0, 100, 0}, 40, true}
+    };
+    return scenes;
+}
+
+/**
+ * @brief Returns the camera of a scene, as built by the examples.
+ *
+ * @param scene - The benchmarked scene.
+ * @return Camera - The camera.
+ */
+Camera bench_camera(const bench_scene &scene){
+    return {scene.lookFrom, scene.lookAt, {0, 1, 0}, scene.vfov, scene.width / scene.height, 0, 10, 0, 1};
+}
@@ -0,0 +1,299 @@
+#include "../src/srt/srt.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/srt/paths.h"
+#include "../src/srt/textures/ImageTexture.hpp"
+#include "bench_scenes.hpp"
+
+/**************************************** DEFINE ****************************************/
+
+#define BATCH 1024
+#define SEED 42
+// How many times slower an insertion in the largest tree of BM_BVHInsert can be than in the smallest one.
+#define MAX_INSERT_GROWTH 8
+
+/**************************************** GLOBAL ****************************************/
+
+const float MAX_FLOAT = std::numeric_limits<float>::max();
+
+/**************************************** FUNCTIONS ****************************************/
+
+// Returns BATCH random vectors with components in [-1, 1), always the same ones.
+const vector<Vec3>& random_vectors(){
+    static const vector<Vec3> vectors = [](){
+        rand_seed(SEED);
+        vector<Vec3> vectors;
+        for(size_t i = 0; i < BATCH; ++i)
+            vectors.emplace_back(2 * rand_float() - 1, 2 * rand_float() - 1, 2 * rand_float() - 1);
+        return vectors;
+    }();
+    return vectors;
+}
+
+// Returns BATCH rays shot from around the origin towards a point near (0, 0, -5), so that about half of
+// them hit the shapes centered there.
+const vector<Ray>& random_rays(){
+    static const vector<Ray> rays = [](){
+        const vector<Vec3> &vectors = random_vectors();
+        vector<Ray> rays;
+        for(size_t i = 0; i < BATCH; ++i)
+            rays.emplace_back(0.1 * vectors[i], Vec3{0, 0, -5} + 1.5 * vectors[(i + 1) % BATCH]);
+        return rays;
+    }();
+    return rays;
+}
+
+// Intersects the batch of rays with a hitable.
+void intersect(benchmark::State &state, const Hitable &hitable){
+    const vector<Ray> &rays = random_rays();
+    for(auto _ : state)
+        for(const Ray &ray : rays)
+            benchmark::DoNotOptimize(hitable.intersection(ray, 0.001, MAX_FLOAT));
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+// Scatters the batch of rays on a material, as if they hit a surface facing them.
+void scatter(benchmark::State &state, const materials::Material &material){
+    const vector<Ray> &rays = random_rays();
+    const Vec3 point{0, 0, -5}, normal{0, 0, 1}, coords{0.5, 0.5, 0};
+    Vec3 attenuation;
+    for(auto _ : state){
+        for(const Ray &ray : rays){
+            Ray scattered{ray};
+            benchmark::DoNotOptimize(material.scatter(scattered, attenuation, point, normal, coords));
+            benchmark::DoNotOptimize(attenuation);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+/**************************************** VECTORS ****************************************/
+
+void BM_Vec3Add(benchmark::State &state){
+    const vector<Vec3> &v = random_vectors();
+    for(auto _ : state)
+        for(size_t i = 0; i < BATCH; ++i)
+            benchmark::DoNotOptimize(v[i] + v[BATCH - 1 - i]);
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_Vec3Add);
+
+void BM_Vec3Dot(benchmark::State &state){
+    const vector<Vec3> &v = random_vectors();
+    for(auto _ : state)
+        for(size_t i = 0; i < BATCH; ++i)
+            benchmark::DoNotOptimize(v[i] * v[BATCH - 1 - i]);
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_Vec3Dot);
+
+void BM_Vec3Cross(benchmark::State &state){
+    const vector<Vec3> &v = random_vectors();
+    for(auto _ : state)
+        for(size_t i = 0; i < BATCH; ++i)
+            benchmark::DoNotOptimize(v[i].cross(v[BATCH - 1 - i]));
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_Vec3Cross);
+
+void BM_Vec3Normalize(benchmark::State &state){
+    const vector<Vec3> &v = random_vectors();
+    for(auto _ : state)
+        for(size_t i = 0; i < BATCH; ++i)
+            benchmark::DoNotOptimize(v[i].normalize());
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_Vec3Normalize);
+
+/**************************************** SHAPES ****************************************/
+
+void BM_AABBHit(benchmark::State &state){
+    const vector<Ray> &rays = random_rays();
+    const AABB box{{-1, -1, -6}, {1, 1, -4}};
+    for(auto _ : state)
+        for(const Ray &ray : rays)
+            benchmark::DoNotOptimize(box.hit(ray, 0.001, MAX_FLOAT));
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_AABBHit);
+
+void BM_SphereIntersection(benchmark::State &state){
+    intersect(state, Sphere{{0, 0, -5}, 1, make_shared<Metal>(Vec3{0.5}, 0)});
+}
+BENCHMARK(BM_SphereIntersection);
+
+void BM_AARectangleIntersection(benchmark::State &state){
+    intersect(state, AARectangle{AARectangle::XY, -1, 1, -1, 1, -5, make_shared<Metal>(Vec3{0.5}, 0)});
+}
+BENCHMARK(BM_AARectangleIntersection);
+
+void BM_AABoxIntersection(benchmark::State &state){
+    intersect(state, AABox{{-1, -1, -6}, {1, 1, -4}, make_shared<Metal>(Vec3{0.5}, 0)});
+}
+BENCHMARK(BM_AABoxIntersection);
+
+/**************************************** BVH ****************************************/
+
+// Builds the tree of n random spheres.
+void BM_BVHBuild(benchmark::State &state){
+    const size_t n = state.range(0);
+    const shared_ptr<Material> material = make_shared<Metal>(Vec3{0.5}, 0);
+    vector<shared_ptr<Hitable>> spheres;
+
+    rand_seed(SEED);
+    for(size_t i = 0; i < n; ++i)
+        spheres.push_back(make_shared<Sphere>(Vec3{100 * rand_float(), 100 * rand_float(), 100 * rand_float()},
+                                              rand_float(), material));
+
+    // The tree sorts the spheres it is given and draws its split axes, so every build starts again from
+    // the same order and seed, outside of the timing.
+    vector<shared_ptr<Hitable>> input;
+    for(auto _ : state){
+        state.PauseTiming();
+        input = spheres;
+        rand_seed(SEED);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(BVH{input, 0, 1});
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_BVHBuild)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// Inserts spheres farther and farther away in the tree of n random spheres, the worst case for a tree
+// that is not rebalanced. Fails if the tree gets deeper than the bound kept by the rebalancing, or if an
+// insertion gets more than MAX_INSERT_GROWTH times slower than in the smallest tree, which is run first:
+// an insertion must depend on the depth of the tree, not on the number of spheres.
+void BM_BVHInsert(benchmark::State &state){
+    static size_t smallest = 0;
+    static double smallestTime = 0;
+    const size_t n = state.range(0);
+    const shared_ptr<Material> material = make_shared<Metal>(Vec3{0.5}, 0);
+    vector<shared_ptr<Hitable>> spheres;
+
+    rand_seed(SEED);
+    for(size_t i = 0; i < n; ++i)
+        spheres.push_back(make_shared<Sphere>(Vec3{100 * rand_float(), 100 * rand_float(), 100 * rand_float()},
+                                              rand_float(), material));
+    Scene scene{1, 1, "insert"};
+    scene.addHitables(spheres);
+    scene.buildBVH();
+    // The first edit indexes the tree.
+    size_t inserted = 0;
+    scene.insertHitable(make_shared<Sphere>(Vec3{1000.f + inserted++, 0, 0}, 0.5, material));
+
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(auto _ : state)
+        scene.insertHitable(make_shared<Sphere>(Vec3{1000.f + inserted++, 0, 0}, 0.5, material));
+    const double time = chrono::duration<double>(chrono::steady_clock::now() - start).count() / state.iterations();
+
+    if(smallest == 0 || n <= smallest){
+        smallest = n;
+        smallestTime = time;
+    }
+    const size_t depth = scene.getHierarchyDepth();
+    if(depth > BVH::MAX_IMBALANCE * log2(static_cast<float>(n + inserted)))
+        state.SkipWithError(("The tree is " + to_string(depth) + " nodes deep").c_str());
+    else if(time > MAX_INSERT_GROWTH * smallestTime)
+        state.SkipWithError(("An insertion takes " + to_string(time / smallestTime) + " times as long as with " +
+                             to_string(smallest) + " spheres").c_str());
+    state.counters["depth"] = depth;
+    state.counters["us/insert"] = time * 1e6;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BVHInsert)->Arg(1000)->Arg(100000);
+
+// Shoots the primary rays of a scene of the scene builder through its BVH.
+void BM_BVHTraversal(benchmark::State &state){
+    const bench_scene &desc = bench_scenes()[state.range(0)];
+    rand_seed(SEED);
+    const Scene scene = desc.build(desc.width, desc.height);
+    Camera camera = bench_camera(desc);
+    vector<Ray> rays;
+    for(size_t i = 0; i < BATCH; ++i)
+        rays.push_back(camera.get_ray(rand_float(), rand_float()));
+
+    for(auto _ : state)
+        for(const Ray &ray : rays)
+            benchmark::DoNotOptimize(scene.intersection(ray, 0.001, MAX_FLOAT));
+
+    state.SetLabel(desc.name);
+    state.counters["rays"] = benchmark::Counter(state.iterations() * BATCH, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BVHTraversal)->DenseRange(0, 3);
+
+/**************************************** MATERIALS ****************************************/
+
+void BM_LambertianScatter(benchmark::State &state){
+    scatter(state, Lambertian{make_shared<StaticTexture>(Vec3{0.5})});
+}
+BENCHMARK(BM_LambertianScatter);
+
+void BM_MetalScatter(benchmark::State &state){
+    scatter(state, Metal{Vec3{0.7, 0.6, 0.5}, 0.3});
+}
+BENCHMARK(BM_MetalScatter);
+
+void BM_DielectricScatter(benchmark::State &state){
+    scatter(state, Dielectric{1.5});
+}
+BENCHMARK(BM_DielectricScatter);
+
+// A light does not scatter, so its emission is measured.
+void BM_DiffuseLightEmit(benchmark::State &state){
+    const DiffuseLight light{make_shared<StaticTexture>(Vec3{4})};
+    const vector<Vec3> &v = random_vectors();
+    Vec3 emission;
+    for(auto _ : state){
+        for(size_t i = 0; i < BATCH; ++i){
+            benchmark::DoNotOptimize(light.emit(v[i], {0.5, 0.5, 0}, emission));
+            benchmark::DoNotOptimize(emission);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_DiffuseLightEmit);
+
+/**************************************** TEXTURES ****************************************/
+
+// Samples the image with the footprint given by the argument, in thousandths of the texture.
+void BM_ImageTextureValue(benchmark::State &state){
+    const ImageTexture texture{FILES_DIR + "textures/earth.jpg"};
+    const vector<Vec3> &v = random_vectors();
+    const float footprint = state.range(0) / 1000.f;
+    texture.value(0, 0, {0, 0, 0});
+
+    for(auto _ : state)
+        for(size_t i = 0; i < BATCH; ++i)
+            benchmark::DoNotOptimize(texture.value(0.5f * v[i].x() + 0.5f, 0.5f * v[i].y() + 0.5f, v[i], footprint));
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+BENCHMARK(BM_ImageTextureValue)->Arg(0)->Arg(1)->Arg(10);
+
+/**************************************** MAIN ****************************************/
+
+// The results are written as JSON on the standard output, unless another format is asked, so that
+// they can be stored and compared across the commits.
+int main(int argc, char **argv){
+    vector<char*> args{argv, argv + argc};
+    char json[] = "--benchmark_format=json";
+    if(none_of(args.begin() + 1, args.end(), [](const char *arg){ return strncmp(arg, "--benchmark_format", 18) == 0; }))
+        args.push_back(json);
+
+    int count = args.size();
+    benchmark::Initialize(&count, args.data());
+    if(benchmark::ReportUnrecognizedArguments(count, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include "../src/srt/srt.h"
+
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../src/srt/utility/Stopwatch.hpp"
+#include "bench_scenes.hpp"
+
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define SAMPLES 4
+#define MAX_DEPTH 50
+#define SEED 42
+
+/**************************************** TYPEDEF ****************************************/
+
+/// The paths traced to render a scene and the rays they have shot: the primary ones, from the camera, and all.
+typedef struct rc{
+    size_t paths, primary, total;
+} ray_count;
+
+/**************************************** GLOBAL ****************************************/
+
+const float MAX_FLOAT = std::numeric_limits<float>::max();
+
+/**************************************** FUNCTIONS ****************************************/
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ *
+ * @return double - The peak in MB.
+ */
+double peak_rss(){
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / (1024. * 1024.);
+#else
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.;
+#endif
+}
+
+// Traces a path as basic_raytracer does, counting the primary rays and all the rays shot. The color is
+// returned so that the work is not optimized away.
+Vec3 color(const Ray &ray, const Scene &scene, const bool sky, const float spread, size_t &primary, size_t &rays){
+    Ray currRay{ray};
+    size_t depth = 0;
+    float distance = 0;
+    Vec3 color = {1, 1, 1}, attenuation, emission;
+    const materials::MaterialTable &materialTable = scene.getMaterials();
+    Hitable::hit_record container = scene.intersection(currRay, 0.001, MAX_FLOAT);
+    ++primary;
+    ++rays;
+
+    while(container.hit){
+        Vec3 texturesCoords = container.object->getTextureCoords(container.point, container.index);
+        distance += container.t;
+        texturesCoords = {texturesCoords.x(), texturesCoords.y(), texturesCoords.z() * spread * distance};
+
+        if(!materialTable.emit(container.materialId, container.point, texturesCoords, emission))
+            emission = {0, 0, 0};
+
+        if(depth++ < MAX_DEPTH && materialTable.scatter(container.materialId, currRay, attenuation, container.point,
+                                                        container.normal, texturesCoords))
+            color = color.multiplication(emission + attenuation);
+        else
+            return color.multiplication(emission);
+
+        container = scene.intersection(currRay, 0.001, MAX_FLOAT);
+        ++rays;
+    }
+
+    if(!sky)    return {0, 0, 0};
+    const float t = 0.5 * (currRay.getDirection().y() + 1);
+    return color.multiplication((1 - t) * Vec3{1, 1, 1} + t * Vec3{0.5, 0.7, 1.});
+}
+
+// Renders the scene with SAMPLES paths per pixel, without writing the image. Every thread draws its
+// numbers from its own sequence, see rand_float, so the threads do not contend for the generator.
+ray_count render(const Scene &scene, const bench_scene &desc, float &checksum){
+    const size_t width = desc.width, height = desc.height;
+    const float spread = desc.vfov * M_PI / 180 / height;
+    Camera cam = bench_camera(desc);
+    size_t paths = 0, primary = 0, rays = 0;
+    float sum = 0;
+
+    #pragma omp parallel for reduction(+:paths, primary, rays, sum) schedule(dynamic)
+    for(size_t j = 0; j < height; ++j){
+        for(size_t i = 0; i < width; ++i){
+            for(size_t k = 0; k < SAMPLES; ++k){
+                const float u = (i + rand_float()) / width, v = (j + rand_float()) / height;
+                const Vec3 c = color(cam.get_ray(u, v), scene, desc.sky, spread, primary, rays);
+                sum += c.x() + c.y() + c.z();
+                ++paths;
+            }
+        }
+    }
+
+    checksum += sum;
+    return {paths, primary, rays};
+}
+
+/**************************************** MAIN ****************************************/
+
+// Renders the scenes of the scene builder headlessly, at the resolution of the examples and with fixed
+// seeds, and reports the throughput with 1, 2, 4, ... threads up to the given number (all by default).
+// Usage: srt_scene_bench [max threads]
+int main(int argc, char **argv){
+    size_t maxThreads = 1;
+#ifdef _OPENMP
+    maxThreads = omp_get_max_threads();
+#endif
+    if(argc > 1)    maxThreads = std::max<size_t>(std::stoul(argv[1]), 1);
+
+    Stopwatch sw;
+    float checksum = 0;
+
+    cout << fixed << setprecision(3);
+    cout << "scene\t\t\tthreads\tbuild (ms)\tBVH (ms)\tprimary (Mrays/sec)\ttotal (Mrays/sec)\tpaths (M/sec)\tspeedup\tpeak RSS (MB)" << endl;
+
+    for(const bench_scene &desc : bench_scenes()){
+        rand_seed(SEED);
+        sw.start();
+        Scene scene = desc.build(desc.width, desc.height);
+        const double buildTime = sw.end();
+
+        // The scene is built with its tree, so the tree is built again to time it alone.
+        sw.start();
+        scene.buildBVH();
+        const double bvhTime = sw.end();
+
+        // Double the threads up to the maximum, which is always measured.
+        vector<size_t> threadCounts;
+        for(size_t threads = 1; threads < maxThreads; threads *= 2)
+            threadCounts.push_back(threads);
+        threadCounts.push_back(maxThreads);
+
+        double singleTime = 0;
+        for(const size_t threads : threadCounts){
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            rand_seed(SEED);
+            sw.start();
+            const ray_count count = render(scene, desc, checksum);
+            const double time = sw.end();
+            if(threads == 1)    singleTime = time;
+
+            cout << left << setw(24) << desc.name << right << threads << '\t' << buildTime * 1e3 << "\t\t" << bvhTime * 1e3 << "\t\t"
+                 << count.primary / time / 1e6 << "\t\t\t" << count.total / time / 1e6 << "\t\t\t"
+                 << count.paths / time / 1e6 << "\t\t" << singleTime / time << '\t' << peak_rss() << endl;
+        }
+    }
+
+    // Print the checksum, so that the compiler does not remove the rendering.
+    cout << "checksum: " << checksum << endl;
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "../src/srt/srt.h"
+
+#include <iostream>
+#include <vector>
+
+#include "../src/srt/geometry/AABB.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::geometry;
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define BOXES 4096
+#define RAYS 4096
+#define REPETITIONS 4
+#define SEED 42
+
+/**************************************** FUNCTIONS ****************************************/
+
+/**
+ * @brief The slab test as it was before the rays stored their inverse direction: a division
+ *        per axis, a conditional swap and an early exit. It is kept here as the reference.
+ */
+bool divisionHit(const AABB &box, const Ray &ray, float tmin, float tmax){
+    for(uint8_t i = 0; i < 3; ++i){
+        const float invD = 1 / ray.getDirection()[i];
+        float t0 = (box.getMin()[i] - ray.getOrigin()[i]) * invD;
+        float t1 = (box.getMax()[i] - ray.getOrigin()[i]) * invD;
+
+        if(invD < 0)    std::swap(t0, t1);
+
+        tmin = t0 > tmin ? t0 : tmin;
+        tmax = t1 < tmax ? t1 : tmax;
+
+        if(tmax <= tmin)    return false;
+    }
+    return true;
+}
+
+/**************************************** MAIN ****************************************/
+
+// Measures the ray-box tests per second of the old slab test and of the branchless one used by the
+// BVH. A part of the rays is axis aligned, so that the zero components of the direction are tested too.
+int main(int argc, char **argv){
+    vector<AABB> boxes;
+    vector<Ray> rays;
+    Stopwatch sw;
+
+    rand_seed(SEED);
+    for(size_t i = 0; i < BOXES; ++i){
+        const Vec3 center{20 * (rand_float() - 0.5f), 20 * (rand_float() - 0.5f), 20 * (rand_float() - 0.5f)};
+        const Vec3 extent{rand_float(), rand_float(), rand_float()};
+        boxes.emplace_back(center - extent, center + extent);
+    }
+    for(size_t i = 0; i < RAYS; ++i){
+        Vec3 direction{rand_float() - 0.5f, rand_float() - 0.5f, rand_float() - 0.5f};
+        if(i % 8 == 0)  direction = Vec3{0, direction.y(), direction.z()};
+        if(i % 16 == 0) direction = Vec3{0, 0, direction.z()};
+        rays.emplace_back(Vec3{10 * (rand_float() - 0.5f), 10 * (rand_float() - 0.5f), 10 * (rand_float() - 0.5f)}, direction);
+    }
+
+    cout << "test\t\tMtests/sec\thits" << endl;
+
+    const auto report = [&](const string &name, const auto &hit){
+        size_t hits = 0;
+        sw.start();
+        for(size_t r = 0; r < REPETITIONS; ++r)
+            for(const Ray &ray : rays)
+                for(const AABB &box : boxes)
+                    hits += hit(box, ray);
+        const double time = sw.end();
+
+        cout << name << "\t" << double(BOXES) * RAYS * REPETITIONS / 1e6 / time << "\t\t" << hits / REPETITIONS << endl;
+    };
+
+    report("division", [](const AABB &box, const Ray &ray){ return divisionHit(box, ray, 0.001, numeric_limits<float>::max()); });
+    report("branchless", [](const AABB &box, const Ray &ray){ return box.hit(ray, 0.001, numeric_limits<float>::max()); });
+
+    return 0;
+}
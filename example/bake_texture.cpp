@@ -0,0 +1,48 @@
+#include "../src/srt/srt.h"
+
+#include <iostream>
+
+#include "../src/srt/textures/ImageTexture.hpp"
+#include "../src/srt/textures/MipMap.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::textures;
+using namespace srt::utility;
+
+/**************************************** MAIN ****************************************/
+
+// Bakes the images in the tiled mip-mapped format that the renderer maps in memory.
+// Usage: bake_texture <image> [<baked file>]. The baked file defaults to the image path with the
+// BAKED_EXTENSION appended.
+int main(int argc, char **argv){
+    if(argc < 2){
+        cerr << "Usage: " << argv[0] << " <image> [<baked file>]" << endl;
+        return 1;
+    }
+
+    const string imagePath = argv[1];
+    const string bakedPath = argc > 2 ? argv[2] : imagePath + ImageTexture::BAKED_EXTENSION;
+    Stopwatch sw;
+
+    try{
+        sw.start();
+        ImageTexture::bake(imagePath, bakedPath);
+        const double bakeTime = sw.end();
+
+        sw.start();
+        MipMap baked{bakedPath};
+        const double mapTime = sw.end();
+
+        cout << bakedPath << ": " << baked.getWidth() << "x" << baked.getHeight() << ", " << baked.getChannels()
+             << " channels, " << baked.getLevels() << " levels" << endl;
+        cout << "bake (sec): " << bakeTime << "\tmap (sec): " << mapTime << endl;
+    }
+    catch(const exception &e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
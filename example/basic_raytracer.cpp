@@ -1,17 +1,26 @@
 #include "../src/srt/srt.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 #include "../src/srt/paths.h"
 #include "scene_builder.hpp"
+#include "parse_scene.hpp"
 #include "../src/srt/Ray.hpp"
+#include "../src/srt/Animation.hpp"
 #include "../src/srt/Camera.hpp"
+#include "../src/srt/Denoiser.hpp"
+#include "../src/srt/FrameBuffer.hpp"
+#include "../src/srt/utility/Profiler.hpp"
+#include "../src/srt/utility/RenderStatus.hpp"
 #include "../src/srt/utility/Stopwatch.hpp"
+#include "../src/srt/utility/TraversalStats.hpp"
 #include "../src/srt/geometry/shapes/MovingSphere.hpp"
 #include "../src/srt/textures/StaticTexture.hpp"
 #include "../src/srt/textures/CheckerTexture.hpp"
@@ -35,27 +44,55 @@ using namespace srt::utility;
 #define SAMPLES 100
 #define MAX_DEPTH 50
 
+// Filter the image with the albedo, the normals and the depth of the first hits, written next to it.
+#define DENOISE 0
+// The output variables written next to the image, see FrameBuffer::NAMES, for example "direct,indirect,object_id".
+#define AOVS ""
+
 /**************************************** TYPEDEF ****************************************/
 
 typedef vector<Vec3> pixel_vector;
 
+/// How a scene is shot: the camera and what the rays that leave the scene see.
+typedef struct vs{
+    SceneParser::camera_settings camera;
+    bool sky;
+    Vec3 background;
+} view_settings;
+
 /**************************************** HEADER ****************************************/
 
-pixel_vector raytracing(Scene &scene, const Vec3 &origin = {0, 0, 0});
-void draw(const Scene &scene, const pixel_vector &pixels);
+view_settings compiled_view();
+pixel_vector raytracing(Scene &scene, const view_settings &view);
+pixel_vector develop(const Scene &scene, pixel_vector pixels);
+void animate(Scene &scene, const Animation &animation, view_settings view, const float first, const float last);
+void draw(const Scene &scene, const pixel_vector &pixels, const string &name);
+void drawStats(const Scene &scene);
+void drawOutputs(const Scene &scene);
 
 /**************************************** GLOBAL ****************************************/
 
 const Vec3 BASE_COLOR{170, 170, 170};
 const float MAX_FLOAT = std::numeric_limits<float>::max();
 
+#ifdef SRT_TRAVERSAL_STATS
+// The nodes visited, the primitives tested and the bounces of every pixel, averaged on the samples.
+vector<float> nodesMap, primitivesMap, bouncesMap;
+#endif
+
+// The output variables of the pixels, with the features and the image before the filter if it is denoised.
+FrameBuffer outputs;
+
 /**************************************** MAIN ****************************************/
 
+// Usage: basic_raytracer [scene.json [first last]]. Without a scene file, the scene selected by TARGET_SCENE is built.
+// If the scene file has an animation, its frames are rendered, or the frames from first to last.
 int main(int argc, char **argv){
     srand(static_cast <unsigned> (time(0))); // Init random seed.
     Stopwatch sw, sw1;
 
     cout << "Starting ray tracer..." << endl;
+    Profiler::enable();
 
     // Build up the scene.
     //auto files = FileManager::getFiles(FILES_DIR + "scenes/");
@@ -66,31 +103,68 @@ int main(int argc, char **argv){
         // PMScene scene{100, 200, "test"};
         // Scene scene = build_scenes(FILES_DIR + "scenes/" + files[i]);
 
-        #if TARGET_SCENE == RANDOM_SCENE
-        // Random scene.
-        Scene scene = random_scene(512, 384);
-        #elif TARGET_SCENE == CORNELL_SCENE
-        // Cornell box.
-        Scene scene = cornell_box(580, 720);
-        #elif TARGET_SCENE == MY_RANDOM_SCENE
-        // My random scene.
-        Scene scene = my_random_scene(512, 384, 1000);
-        #elif TARGET_SCENE == BVH_SCENE
-        // BVH scene.
-        Scene scene = BVH_scene(512, 384);
-        #endif
+        view_settings view = compiled_view();
+        Animation animation;
+        Scene scene = [argc, argv, &view, &animation](){
+            Profiler::Zone zone{"scene build"};
+            if(argc > 1){
+                // The static scenes are loaded from their cache from the second render on.
+                SceneCache::scene_view cached;
+                Scene scene = load_scene(argv[1], cached, animation);
+                view = {cached.camera, cached.sky, cached.background};
+                return scene;
+            }
+            #if TARGET_SCENE == RANDOM_SCENE
+            // Random scene.
+            return random_scene(512, 384);
+            #elif TARGET_SCENE == CORNELL_SCENE
+            // Cornell box.
+            return cornell_box(580, 720);
+            #elif TARGET_SCENE == MY_RANDOM_SCENE
+            // My random scene.
+            return my_random_scene(512, 384, 1000);
+            #elif TARGET_SCENE == BVH_SCENE
+            // BVH scene.
+            return BVH_scene(512, 384);
+            #endif
+        }();
 
         cout << "...Ending scene creation in " << sw1.end() << "sec..." << endl;
+        const materials::MaterialTable::interning_stats interning = scene.getMaterials().getInterningStats();
+        cout << "...Interned " << interning.materials << " materials in " << interning.uniqueMaterials << " and "
+             << interning.textures << " textures in " << interning.uniqueTextures << ", saving about "
+             << interning.bytesSaved / 1024.0 << " KB..." << endl;
+        for(const auto &arena : {make_pair("objects", scene.getArena()->getStats()), make_pair("BVH nodes", scene.getTreeArenaStats())})
+            cout << "...Arena of the " << arena.first << ": " << arena.second.allocations << " allocations in " << arena.second.blocks 
+                 << " blocks, " << arena.second.used / 1024.0 << " KB used of " << arena.second.reserved / 1024.0 << " KB, "
+                 << arena.second.getFragmentation() * 100 << "% fragmentation..." << endl;
+
+        const float first = argc > 3 ? stof(argv[2]) : animation.getFirstFrame(),
+                    last = argc > 3 ? stof(argv[3]) : animation.getLastFrame();
+        if(last > first)
+            animate(scene, animation, view, first, last);
+        else{
+            // Compute color through raytracing.
+            sw1.start();
+            pixel_vector pixels = raytracing(scene, view);
+            cout << "...Ending color computation in " << sw1.end() << "sec..." << endl;
+
+            sw1.start();
+            pixels = develop(scene, pixels);
+            #if DENOISE
+            cout << "...Ending denoising in " << sw1.end() << "sec..." << endl;
+            #endif
+
+            // Render the scene.
+            sw1.start();
+            draw(scene, pixels, scene.getName());
+            drawStats(scene);
+            drawOutputs(scene);
+            cout << "...Ending scene rendering in " << sw1.end() << "sec..." << endl;
+        }
 
-        // Compute color through raytracing.
-        sw1.start();
-        pixel_vector pixels = raytracing(scene);
-        cout << "...Ending color computation in " << sw1.end() << "sec..." << endl;
-
-        // Render the scene.
-        sw1.start();
-        draw(scene, pixels);
-        cout << "...Ending scene rendering in " << sw1.end() << "sec..." << endl;
+        // Write the zones of the threads, to be opened in chrome://tracing or Perfetto.
+        Profiler::write(FILES_DIR + scene.getName() + "_trace.json");
     // }
 
     return 0;
@@ -99,93 +173,269 @@ int main(int argc, char **argv){
 
 /**************************************** FUNCTIONS ****************************************/
 
-Vec3 color(const Ray &ray, const Scene &scene){
+// Returns the view of the scene selected by TARGET_SCENE.
+view_settings compiled_view(){
+    #if TARGET_SCENE == RANDOM_SCENE
+    // Random scene camera.
+    return {{{13, 2, 3}, {0, 0, 0}, {0, 1, 0}, 40, 0, 10, 0, 1}, true, {0, 0, 0}};
+    #elif TARGET_SCENE == CORNELL_SCENE
+    // Cornell box camera.
+    return {{{278, 278, -800}, {278, 278, 0}, {0, 1, 0}, 40, 0, 10, 0, 1}, false, {0, 0, 0}};
+    #elif TARGET_SCENE == MY_RANDOM_SCENE
+    // My random scene camera.
+    return {{{560, 850, -1050}, {560, 250, 0}, {0, 1, 0}, 40, 0, 10, 0, 1}, true, {0, 0, 0}};
+    #elif TARGET_SCENE == BVH_SCENE
+    // My random scene camera.
+    return {{{0, 150, -600}, {0, 100, 0}, {0, 1, 0}, 40, 0, 10, 0, 1}, true, {0, 0, 0}};
+    #endif
+}
+
+// Puts the light of a path in the beauty and in the part given by the bounces it has made, see FrameBuffer;
+// only the channels in the mask are written.
+Vec3 output(FrameBuffer::sample *aov, const uint32_t mask, const Vec3 &light, const size_t bounces){
+    if(FrameBuffer::isEnabled(mask, FrameBuffer::BEAUTY))
+        aov->values[FrameBuffer::BEAUTY] = light;
+    const FrameBuffer::Channel part = bounces == 0 ? FrameBuffer::EMISSION : bounces == 1 ? FrameBuffer::DIRECT : FrameBuffer::INDIRECT;
+    for(const FrameBuffer::Channel c : {FrameBuffer::EMISSION, FrameBuffer::DIRECT, FrameBuffer::INDIRECT})
+        if(FrameBuffer::isEnabled(mask, c))
+            aov->values[c] = c == part ? light : Vec3{0, 0, 0};
+    return light;
+}
+
+// The spread is the angle covered by a pixel, used to compute the footprint of the ray on the textures.
+// The output variables in the mask (see FrameBuffer) are written in aov, which is needed only if the mask is not 0;
+// every enabled channel is written, so aov does not have to be cleared between the paths.
+Vec3 color(const Ray &ray, const Scene &scene, const float spread, const view_settings &view, FrameBuffer::sample *aov = nullptr,
+           const uint32_t mask = 0){
     Ray currRay{ray};
     size_t depth = 0;
+    float distance = 0;
     Vec3 color = {1, 1, 1}, attenuation, emission;
+    const materials::MaterialTable &materialTable = scene.getMaterials();
     Hitable::hit_record container = scene.intersection(currRay, 0.001, MAX_FLOAT);
 
     // Compute the attenuation factor of the bouncing ray.
     while(container.hit){
-        auto material = container.object->getMaterial();
-        Vec3 texturesCoords = container.object->getTextureCoords(container.point);
+        Vec3 texturesCoords = container.object->getTextureCoords(container.point, container.index);
+
+        // Turn the texture scale into the footprint of the ray cone on the surface.
+        distance += container.t;
+        texturesCoords = {texturesCoords.x(), texturesCoords.y(), texturesCoords.z() * spread * distance};
 
         // Add emission if one.
-        if(!material->emit(container.point, texturesCoords, emission))
+        if(!materialTable.emit(container.materialId, container.point, texturesCoords, emission))
             emission = {0, 0, 0};
 
-        if(depth++ < MAX_DEPTH && material->scatter(currRay, attenuation, container.point, 
-                                            container.normal, 
-                                            texturesCoords ))
+        const bool scattered = depth++ < MAX_DEPTH && materialTable.scatter(container.materialId, currRay, attenuation, 
+                                                                             container.point, container.normal, texturesCoords);
+        if(mask != 0 && depth == 1){
+            // A light is told apart from the surfaces around it by its emission.
+            const bool emits = emission.x() > 0 || emission.y() > 0 || emission.z() > 0;
+            if(FrameBuffer::isEnabled(mask, FrameBuffer::ALBEDO))
+                aov->values[FrameBuffer::ALBEDO] = emits ? emission : scattered ? attenuation : Vec3{0, 0, 0};
+            if(FrameBuffer::isEnabled(mask, FrameBuffer::NORMAL))
+                aov->values[FrameBuffer::NORMAL] = container.normal.normalize();
+            if(FrameBuffer::isEnabled(mask, FrameBuffer::DEPTH))
+                aov->values[FrameBuffer::DEPTH] = container.t * ray.getDirection().length();
+            if(FrameBuffer::isEnabled(mask, FrameBuffer::OBJECT_ID))
+                aov->values[FrameBuffer::OBJECT_ID] = FrameBuffer::objectId(container);
+            if(FrameBuffer::isEnabled(mask, FrameBuffer::MATERIAL_ID))
+                aov->values[FrameBuffer::MATERIAL_ID] = container.materialId + 1.f;
+        }
+
+        if(scattered){
+            SRT_COUNT_BOUNCE();
             color = color.multiplication(emission + attenuation); 
+        }
         else
-            return color.multiplication(emission);
+            return output(aov, mask, color.multiplication(emission), depth - 1);
 
         container = scene.intersection(currRay, 0.001, MAX_FLOAT);
     }
 
 
-    #if TARGET_SCENE == CORNELL_SCENE
-    return {0, 0, 0};
-    #else
     float t = 0.5 * (currRay.getDirection().y() + 1);
-    return color.multiplication((1 - t ) * Vec3{1, 1, 1} + t * Vec3{0.5, 0.7, 1.});
-    #endif
+    const Vec3 background = view.sky ? (1 - t ) * Vec3{1, 1, 1} + t * Vec3{0.5, 0.7, 1.} : view.background;
+    if(mask != 0 && depth == 0){
+        // The features of a ray that hits nothing: the sky as albedo and 0 for the others.
+        for(const FrameBuffer::Channel c : {FrameBuffer::ALBEDO, FrameBuffer::NORMAL, FrameBuffer::DEPTH, FrameBuffer::OBJECT_ID,
+                                            FrameBuffer::MATERIAL_ID})
+            if(FrameBuffer::isEnabled(mask, c))
+                aov->values[c] = c == FrameBuffer::ALBEDO ? background : Vec3{0, 0, 0};
+    }
+    return output(aov, mask, color.multiplication(background), depth);
 }
 
-pixel_vector raytracing(Scene &scene, const Vec3 &origin){
-    #if TARGET_SCENE == RANDOM_SCENE
-    // Random scene camera.
-    Vec3 lookFrom{13, 2, 3}, lookAt{0, 0, 0};
-    #elif TARGET_SCENE == CORNELL_SCENE
-    // Cornell box camera.
-    Vec3 lookFrom{278, 278, -800}, lookAt{278, 278, 0};
-    #elif TARGET_SCENE == MY_RANDOM_SCENE
-    // My random scene camera.
-    Vec3 lookFrom{560, 850, -1050}, lookAt{560, 250, 0};
-    #elif TARGET_SCENE == BVH_SCENE
-    // My random scene camera.
-    Vec3 lookFrom{0, 150, -600}, lookAt{0, 100, 0};
-    #endif
-    
-    float focus = 10, aperture = 0, vfov = 40;
+pixel_vector raytracing(Scene &scene, const view_settings &view){
+    Profiler::Zone zone{"render"};
+    const SceneParser::camera_settings &settings = view.camera;
     const size_t height = scene.getHeight(), width = scene.getWidth();
-    Camera cam{lookFrom, lookAt, {0, 1, 0}, vfov, width / float(height), aperture, focus, 0, 1};
+    const float spread = settings.vfov * M_PI / 180 / height;
+    Camera cam{settings.lookFrom, settings.lookAt, settings.up, settings.vfov, width / float(height), settings.aperture, 
+               settings.focus, settings.t0, settings.t1};
     pixel_vector pixels(height * width);
+    // Publish the progress for the monitoring tools, every row is a tile.
+    // The render goes on without publishing it if the shared memory cannot be created, as without /dev/shm.
+    unique_ptr<RenderStatus> status;
+    try{
+        status = make_unique<RenderStatus>(scene.getName(), height, width * SAMPLES);
+    }
+    catch(const runtime_error &error){
+        cerr << "...Rendering without publishing the progress: " << error.what() << "..." << endl;
+    }
+    #ifdef SRT_TRAVERSAL_STATS
+    nodesMap.assign(height * width, 0);
+    primitivesMap.assign(height * width, 0);
+    bouncesMap.assign(height * width, 0);
+    #endif
+    // The features of the first hits are needed by the filter.
+    const uint32_t mask = FrameBuffer::parse(AOVS) | (DENOISE ? 1 << FrameBuffer::BEAUTY | 1 << FrameBuffer::ALBEDO |
+                                                                1 << FrameBuffer::NORMAL | 1 << FrameBuffer::DEPTH : 0);
+    outputs = FrameBuffer{width, height, mask};
 
     // pixels.reserve(height * width * 3);
 
     #pragma omp parallel for
     for(size_t j = height; j > 0; --j){
+        Profiler::Zone rowZone{"row"};
         for(size_t i = 0 ; i < width; ++i){
             Vec3 finalColor; 
+            #ifdef SRT_TRAVERSAL_STATS
+            TraversalStats::reset();
+            #endif
+            FrameBuffer::sample path, paths;
             // Anti aliasing.
             for(size_t k = 0; k < SAMPLES; ++k){
                 float u = ((float)i + rand_float()) / width, v = ((float)j + rand_float()) / height;
 
-                finalColor += color(cam.get_ray(u, v), scene);
+                if(mask == 0)
+                    finalColor += color(cam.get_ray(u, v), scene, spread, view);
+                else{
+                    finalColor += color(cam.get_ray(u, v), scene, spread, view, &path, mask);
+                    outputs.add(paths, path);
+                }
             }
 
-            finalColor /= SAMPLES;
-            finalColor = finalColor.map([](float n){return sqrt(n);});
-            finalColor *= 255.99;
-
-            pixels[(height - j) * width + i] = finalColor;
+            // The linear color, developed once the image is complete.
+            pixels[(height - j) * width + i] = finalColor / SAMPLES;
+            if(mask != 0)
+                outputs.set((height - j) * width + i, paths);
+            #ifdef SRT_TRAVERSAL_STATS
+            nodesMap[(height - j) * width + i] = TraversalStats::current.nodes / float(SAMPLES);
+            primitivesMap[(height - j) * width + i] = TraversalStats::current.primitives / float(SAMPLES);
+            bouncesMap[(height - j) * width + i] = TraversalStats::current.bounces / float(SAMPLES);
+            #endif
             // pixels.push_back(finalColor.x()); pixels.push_back(finalColor.y()); pixels.push_back(finalColor.z());
         }
+        if(status != nullptr)
+            status->completeTile();
     }
 
     return pixels;
 }
 
+// Turns the linear colors of the pixels in the values written in the image, filtering them first if DENOISE is set.
+pixel_vector develop(const Scene &scene, pixel_vector pixels){
+    #if DENOISE
+    const pixel_vector &depth = outputs.getChannel(FrameBuffer::DEPTH);
+    Denoiser::feature_buffers features{outputs.getChannel(FrameBuffer::ALBEDO), outputs.getChannel(FrameBuffer::NORMAL),
+                                       vector<float>(depth.size())};
+    transform(depth.begin(), depth.end(), features.depth.begin(), [](const Vec3 &d){ return d.x(); });
+    pixels = Denoiser{static_cast<size_t>(scene.getWidth()), static_cast<size_t>(scene.getHeight())}.denoise(pixels, features);
+    #endif
+
+    for(Vec3 &pixel : pixels)
+        pixel = pixel.map([](float n){return sqrt(n);}) * 255.99;
+    return pixels;
+}
+
+// Renders the frames from first to last in <scene>_<frame>.ppm. Every frame moves the objects and
+// refits the BVH, and the time of this setup is compared with the time of the rendering.
+void animate(Scene &scene, const Animation &animation, view_settings view, const float first, const float last){
+    const SceneParser::camera_settings still = view.camera;
+    double setupTime = 0, renderTime = 0;
+    Stopwatch sw;
+
+    for(float frame = first; frame <= last; ++frame){
+        const Animation::frame_stats stats = animation.setFrame(scene, frame);
+        view.camera = animation.getCamera(frame, still);
+
+        sw.start();
+        const pixel_vector pixels = develop(scene, raytracing(scene, view));
+        const double frameTime = sw.end();
+
+        char number[16];
+        snprintf(number, sizeof(number), "_%04d", static_cast<int>(frame));
+        draw(scene, pixels, scene.getName() + number);
+
+        setupTime += stats.setupTime;
+        renderTime += frameTime;
+        cout << "...Frame " << frame << ": setup in " << stats.setupTime << "sec (" << (stats.rebuilt ? "BVH built again" : "BVH refitted")
+             << ", cost ratio " << stats.costRatio << "), color computation in " << frameTime << "sec..." << endl;
+    }
+
+    cout << "...Frame setup took " << 100 * setupTime / (setupTime + renderTime) << "% of the time..." << endl;
+}
+
 // Use a ppm files to rended the scenes.
-void draw(const Scene &scene, const pixel_vector &pixels){
+void draw(const Scene &scene, const pixel_vector &pixels, const string &name){
+    Profiler::Zone zone{"output"};
     // Write on the file.
-    ofstream image(FILES_DIR + scene.getName() + ".ppm", ios::out | ios::trunc);
+    ofstream image(FILES_DIR + name + ".ppm", ios::out | ios::trunc);
     image << "P3\n" << scene.getWidth() << ' ' << scene.getHeight() << ' ' << "255\n";
 
     // image.write(pixels.data(), pixels.size());
     for(auto pix : pixels)
         image << short(pix.x()) << ' ' << short(pix.y()) << ' ' << short(pix.z()) << '\n';
     image.close();
-}
\ No newline at end of file
+}
+
+// Write the output variables next to the image, in <scene>.srtl and in a <scene>_<variable>.pfm for each one.
+// If the image is denoised, its features and the image before the filter are written as ppm too: the normals are
+// mapped from [-1, 1] to the colors, the depth from the nearest to the farthest hit to white to black.
+void drawOutputs(const Scene &scene){
+    if(outputs.getMask() != 0){
+        outputs.write(FILES_DIR + scene.getName() + FrameBuffer::EXTENSION);
+        outputs.writePFM(FILES_DIR + scene.getName());
+    }
+
+    #if DENOISE
+    const pixel_vector &albedoChannel = outputs.getChannel(FrameBuffer::ALBEDO), &normalChannel = outputs.getChannel(FrameBuffer::NORMAL),
+                       &depthChannel = outputs.getChannel(FrameBuffer::DEPTH), &beautyChannel = outputs.getChannel(FrameBuffer::BEAUTY);
+    float nearest = MAX_FLOAT, farthest = 0;
+    for(const Vec3 &d : depthChannel)
+        if(d.x() > 0){
+            nearest = min(nearest, d.x());
+            farthest = max(farthest, d.x());
+        }
+    const float range = max(farthest - nearest, numeric_limits<float>::min());
+    pixel_vector albedo(albedoChannel.size()), normal(normalChannel.size()), depth(depthChannel.size()), noisy(beautyChannel.size());
+
+    for(size_t i = 0; i < albedo.size(); ++i){
+        albedo[i] = Vec3{albedoChannel[i]}.map([](float n){return sqrt(min(n, 1.f)) * 255.99f;});
+        normal[i] = (normalChannel[i] + Vec3{1, 1, 1}) * 127.99;
+        depth[i] = Vec3{1, 1, 1} * (depthChannel[i].x() > 0 ? 255.99 * (1 - (depthChannel[i].x() - nearest) / range) : 0);
+        noisy[i] = Vec3{beautyChannel[i]}.map([](float n){return sqrt(n);}) * 255.99;
+    }
+
+    draw(scene, albedo, scene.getName() + "_albedo");
+    draw(scene, normal, scene.getName() + "_normal");
+    draw(scene, depth, scene.getName() + "_depth");
+    draw(scene, noisy, scene.getName() + "_noisy");
+    #endif
+}
+
+// Write the heatmaps of the traversal cost and of the bounces next to the image, if they are counted.
+void drawStats(const Scene &scene){
+    #ifdef SRT_TRAVERSAL_STATS
+    const size_t height = scene.getHeight(), width = scene.getWidth();
+    const auto average = [](const vector<float> &map){ return accumulate(map.begin(), map.end(), 0.f) / map.size(); };
+
+    TraversalStats::writeHeatmap(FILES_DIR + scene.getName() + "_nodes.ppm", nodesMap, width, height);
+    TraversalStats::writeHeatmap(FILES_DIR + scene.getName() + "_primitives.ppm", primitivesMap, width, height);
+    TraversalStats::writeHeatmap(FILES_DIR + scene.getName() + "_bounces.ppm", bouncesMap, width, height);
+
+    cout << "...Average per path: " << average(nodesMap) << " nodes, " << average(primitivesMap) << " primitives, "
+         << average(bouncesMap) << " bounces..." << endl;
+    #endif
+}
@@ -0,0 +1,53 @@
+#include "../src/srt/srt.h"
+
+#include <iostream>
+
+#include "parse_scene.hpp"
+#include "../src/srt/SceneCache.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::utility;
+
+/**************************************** MAIN ****************************************/
+
+// Converts a JSON scene in the binary cache that the renderer maps in memory, then compares the time
+// taken to parse the scene and build its hierarchy with the time taken to load the cache.
+// Usage: convert_scene <scene.json> [<cache>]. The cache defaults to the scene path with the
+// SceneCache::EXTENSION in place of its extension.
+int main(int argc, char **argv){
+    if(argc < 2){
+        cerr << "Usage: " << argv[0] << " <scene.json> [<cache>]" << endl;
+        return 1;
+    }
+
+    const string scenePath = argv[1];
+    const string cachePath = argc > 2 ? argv[2] : scenePath.substr(0, scenePath.find_last_of('.')) + SceneCache::EXTENSION;
+    Stopwatch sw;
+
+    try{
+        sw.start();
+        const SceneParser::scene_file scene = SceneParser::load(scenePath);
+        const shared_ptr<ds::FlatBVH> hierarchy = SceneCache::flatten(scene.hitables);
+        const double parseTime = sw.end();
+
+        SceneCache::write(cachePath, scene.name, scene.width, scene.height, {scene.camera, scene.sky, scene.background}, *hierarchy);
+
+        sw.start();
+        SceneCache::scene_view view;
+        const Scene cached = SceneCache::load(cachePath, view);
+        const double loadTime = sw.end();
+
+        cout << cachePath << ": " << cached.getName() << ", " << cached.getWidth() << "x" << cached.getHeight() << ", "
+             << hierarchy->getSphereCount() << " spheres, " << hierarchy->getNodeCount() << " nodes, "
+             << hierarchy->getPalette().size() << " materials" << endl;
+        cout << "parse and build (sec): " << parseTime << "\tload (sec): " << loadTime << endl;
+    }
+    catch(const exception &e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "../src/srt/srt.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+
+#include "scene_builder.hpp"
+#include "../src/srt/Ray.hpp"
+#include "../src/srt/Camera.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::geometry;
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define WIDTH 512
+#define HEIGHT 384
+#define SAMPLES 4
+#define SEED 42
+
+/**************************************** GLOBAL ****************************************/
+
+const float MAX_FLOAT = std::numeric_limits<float>::max();
+const float MOTIONS[] = {0, 0.5, 2, 8};
+
+/**************************************** MAIN ****************************************/
+
+// Measures the BVH traversal speed on the random scene when the diffuse spheres move more and more
+// during the shot. Only primary rays are traced, on a single thread.
+int main(int argc, char **argv){
+    Stopwatch sw;
+
+    cout << "motion\tbuild (sec)\tdepth\tMrays/sec\thits" << endl;
+
+    for(const float motion : MOTIONS){
+        // The scene and the jitter of the rays are drawn with rand_float, the times of the rays with rand.
+        rand_seed(SEED);
+        srand(SEED);
+
+        // Build the scene.
+        sw.start();
+        Scene scene = random_scene(WIDTH, HEIGHT, motion);
+        const double buildTime = sw.end();
+
+        // Shot the primary rays.
+        Camera cam{{13, 2, 3}, {0, 0, 0}, {0, 1, 0}, 40, WIDTH / float(HEIGHT), 0, 10, 0, 1};
+        size_t hits = 0;
+        sw.start();
+        for(size_t j = 0; j < HEIGHT; ++j){
+            for(size_t i = 0; i < WIDTH; ++i){
+                for(size_t k = 0; k < SAMPLES; ++k){
+                    float u = ((float)i + rand_float()) / WIDTH, v = ((float)j + rand_float()) / HEIGHT;
+                    if(scene.intersection(cam.get_ray(u, v), 0.001, MAX_FLOAT).hit)
+                        ++hits;
+                }
+            }
+        }
+        const double traceTime = sw.end();
+        const size_t rays = size_t(WIDTH) * HEIGHT * SAMPLES;
+
+        cout << motion << '\t' << buildTime << "\t\t" << scene.getHierarchyDepth() << '\t'
+             << rays / traceTime / 1e6 << "\t\t" << hits << endl;
+    }
+
+    return 0;
+}
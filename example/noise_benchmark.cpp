@@ -0,0 +1,78 @@
+#include "../src/srt/srt.h"
+
+#include <iostream>
+#include <vector>
+
+#include "../src/srt/textures/NoiseTexture.hpp"
+#include "../src/srt/textures/Perlin.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::geometry;
+using namespace srt::textures;
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define POINTS (1 << 20)
+#define REPETITIONS 8
+#define SEED 42
+
+/**************************************** MAIN ****************************************/
+
+// Measures the noise evaluations per second of the scalar and the batch (SIMD) kernels, for the plain
+// noise and for the fractal sums used by the noise textures.
+int main(int argc, char **argv){
+    vector<float> x(POINTS), y(POINTS), z(POINTS), result(POINTS);
+    Stopwatch sw;
+    float checksum = 0;
+
+    rand_seed(SEED);
+    for(size_t i = 0; i < POINTS; ++i){
+        x[i] = 100 * (rand_float() - 0.5f);
+        y[i] = 100 * (rand_float() - 0.5f);
+        z[i] = 100 * (rand_float() - 0.5f);
+    }
+
+    cout << "kernel\t\tscalar (Meval/sec)\tbatch (Meval/sec)\tspeedup" << endl;
+
+    const auto report = [&](const string &name, const function<float(const Vec3&)> &scalar,
+                            const function<void(float*)> &batch, const size_t octaves){
+        sw.start();
+        for(size_t r = 0; r < REPETITIONS; ++r)
+            for(size_t i = 0; i < POINTS; ++i)
+                checksum += scalar({x[i], y[i], z[i]});
+        const double scalarTime = sw.end();
+
+        sw.start();
+        for(size_t r = 0; r < REPETITIONS; ++r){
+            batch(result.data());
+            checksum += result[r];
+        }
+        const double batchTime = sw.end();
+
+        // Every octave is an evaluation of the noise.
+        const double evaluations = double(POINTS) * REPETITIONS * octaves / 1e6;
+        cout << name << "\t\t" << evaluations / scalarTime << "\t\t\t" << evaluations / batchTime << "\t\t\t"
+             << scalarTime / batchTime << endl;
+    };
+
+    report("noise", [](const Vec3 &p){ return Perlin::noise(p); },
+           [&](float *out){ Perlin::noise(x.data(), y.data(), z.data(), out, POINTS); }, 1);
+    report("fbm", [](const Vec3 &p){ return Perlin::fbm(p); },
+           [&](float *out){ Perlin::fbm(x.data(), y.data(), z.data(), out, POINTS); }, Perlin::DEFAULT_OCTAVES);
+    report("turbulence", [](const Vec3 &p){ return Perlin::turbulence(p); },
+           [&](float *out){ Perlin::turbulence(x.data(), y.data(), z.data(), out, POINTS); }, Perlin::DEFAULT_OCTAVES);
+
+    NoiseTexture marble{NoiseTexture::MARBLE}, wood{NoiseTexture::WOOD};
+    report("marble", [&](const Vec3 &p){ return marble.blend(p); },
+           [&](float *out){ marble.blend(x.data(), y.data(), z.data(), out, POINTS); }, Perlin::DEFAULT_OCTAVES);
+    report("wood", [&](const Vec3 &p){ return wood.blend(p); },
+           [&](float *out){ wood.blend(x.data(), y.data(), z.data(), out, POINTS); }, Perlin::DEFAULT_OCTAVES);
+
+    // Print the checksum, so that the compiler does not remove the evaluations.
+    cout << "checksum: " << checksum << endl;
+
+    return 0;
+}
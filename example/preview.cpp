@@ -0,0 +1,156 @@
+#include "../src/srt/srt.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "../src/srt/paths.h"
+#include "parse_scene.hpp"
+#include "../src/srt/Animation.hpp"
+#include "../src/srt/Camera.hpp"
+#include "../src/srt/Preview.hpp"
+#include "../src/srt/utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt;
+using namespace srt::geometry;
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define DEFAULT_FRAMES 64
+#define DEFAULT_SCALE 4
+#define MAX_DEPTH 50
+#define ORBIT_STEP 2
+
+/**************************************** GLOBAL ****************************************/
+
+const float MAX_FLOAT = std::numeric_limits<float>::max();
+
+/**************************************** FUNCTIONS ****************************************/
+
+// Traces a path as basic_raytracer does, and returns the first point hit with its color.
+Preview::sample color(const Ray &ray, const Scene &scene, const float spread, const SceneParser::scene_file &view){
+    Ray currRay{ray};
+    size_t depth = 0;
+    float distance = 0;
+    Vec3 color = {1, 1, 1}, attenuation, emission;
+    const materials::MaterialTable &materialTable = scene.getMaterials();
+    Hitable::hit_record container = scene.intersection(currRay, 0.001, MAX_FLOAT);
+    const Vec3 first = container.point;
+    const bool hit = container.hit;
+
+    while(container.hit){
+        Vec3 texturesCoords = container.object->getTextureCoords(container.point, container.index);
+        distance += container.t;
+        texturesCoords = {texturesCoords.x(), texturesCoords.y(), texturesCoords.z() * spread * distance};
+
+        if(!materialTable.emit(container.materialId, container.point, texturesCoords, emission))
+            emission = {0, 0, 0};
+
+        if(depth++ < MAX_DEPTH && materialTable.scatter(container.materialId, currRay, attenuation, container.point,
+                                                        container.normal, texturesCoords))
+            color = color.multiplication(emission + attenuation);
+        else
+            return {color.multiplication(emission), first, hit};
+
+        container = scene.intersection(currRay, 0.001, MAX_FLOAT);
+    }
+
+    if(!view.sky)
+        return {color.multiplication(view.background), first, hit};
+    float t = 0.5 * (currRay.getDirection().y() + 1);
+    return {color.multiplication((1 - t) * Vec3{1, 1, 1} + t * Vec3{0.5, 0.7, 1.}), first, hit};
+}
+
+// Turns the camera around the point it looks at, on the plane orthogonal to its up vector.
+Camera::settings orbit(Camera::settings camera, const float degrees){
+    const float theta = degrees * M_PI / 180;
+    const Vec3 axis = camera.up.normalize(), arm = camera.lookFrom - camera.lookAt;
+    camera.lookFrom = camera.lookAt + arm * cos(theta) + axis.cross(arm) * sin(theta) + axis * (axis * arm) * (1 - cos(theta));
+    return camera;
+}
+
+// Writes a frame as a binary ppm, that a viewer reading a stream of images can show.
+void write(ostream &out, const Preview &preview){
+    out << "P6\n" << preview.getWidth() << ' ' << preview.getHeight() << "\n255\n";
+    for(const Vec3 &pix : preview.getImage())
+        for(const float channel : {pix.x(), pix.y(), pix.z()})
+            out.put(static_cast<char>(static_cast<unsigned char>(channel < 0 ? 0 : channel > 255 ? 255 : channel)));
+    out.flush();
+}
+
+/**************************************** MAIN ****************************************/
+
+// Renders an interactive preview of a scene at one sample per pixel, reducing its resolution by scale.
+// The camera follows the keyframes of the animation of the scene, or turns around the point it looks at
+// during the first half of the frames, and then stays still so that the samples accumulate.
+// The frames are written in <scene>_preview_<frame>.ppm, or as a stream of ppm images on the standard
+// output if output is "-", for example: preview scene.json 200 4 - | ffplay -f image2pipe -c:v ppm -i -
+// Usage: preview <scene.json> [frames [scale [output]]]
+int main(int argc, char **argv){
+    if(argc < 2){
+        cerr << "Usage: " << argv[0] << " <scene.json> [frames [scale [output]]]" << endl;
+        return 1;
+    }
+
+    const size_t frames = argc > 2 ? stoul(argv[2]) : DEFAULT_FRAMES;
+    const float scale = argc > 3 ? stof(argv[3]) : DEFAULT_SCALE;
+    const bool stream = argc > 4 && string(argv[4]) == "-";
+    ostream &log = stream ? cerr : cout;
+    Stopwatch sw;
+
+    try{
+        const SceneParser::scene_file sceneFile = SceneParser::load(argv[1]);
+        const Animation &animation = sceneFile.animation;
+        Scene scene = build_scenes(sceneFile);
+        Preview preview{max<size_t>(scene.getWidth() / scale, 1), max<size_t>(scene.getHeight() / scale, 1)};
+        const float spread = sceneFile.camera.vfov * M_PI / 180 / preview.getHeight();
+        const Preview::integrator trace = [&scene, spread, &sceneFile](const Ray &ray){
+            return color(ray, scene, spread, sceneFile);
+        };
+
+        log << "Previewing " << scene.getName() << " at " << preview.getWidth() << "x" << preview.getHeight() << "..." << endl;
+        for(size_t i = 0; i < frames; ++i){
+            // Move the camera and the objects, or only the camera.
+            Camera::settings camera = sceneFile.camera;
+            bool sceneChanged = false;
+            if(animation.isAnimated()){
+                const float frame = min(animation.getFirstFrame() + i, animation.getLastFrame());
+                camera = animation.getCamera(frame, sceneFile.camera);
+                if(animation.getFirstFrame() + i <= animation.getLastFrame()){
+                    animation.setFrame(scene, frame);
+                    sceneChanged = i > 0;
+                }
+            }
+            else
+                camera = orbit(sceneFile.camera, ORBIT_STEP * min(i, frames / 2));
+
+            sw.start();
+            const Preview::frame_stats stats = preview.render(camera, trace, sceneChanged);
+            const double frameTime = sw.end();
+
+            if(stream)
+                write(cout, preview);
+            else{
+                char number[16];
+                snprintf(number, sizeof(number), "_%04zu", i);
+                ofstream image(FILES_DIR + scene.getName() + "_preview" + number + ".ppm", ios::out | ios::trunc | ios::binary);
+                write(image, preview);
+            }
+
+            log << "...Frame " << i << " in " << frameTime * 1000 << "ms (" << 1 / frameTime << " fps), "
+                << (stats.moved ? to_string(static_cast<int>(stats.reused * 100)) + "% of the pixels reprojected, " : "")
+                << stats.samples << " samples per pixel..." << endl;
+        }
+    }
+    catch(const exception &e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
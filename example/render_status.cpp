@@ -0,0 +1,54 @@
+#include "../src/srt/srt.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../src/srt/utility/RenderStatus.hpp"
+
+using namespace std;
+using namespace srt::utility;
+
+/**************************************** DEFINE ****************************************/
+
+#define DEFAULT_INTERVAL 1000
+
+/**************************************** MAIN ****************************************/
+
+// Polls the status published by a rendering process and prints it, until the render ends.
+// Usage: render_status <pid> [interval in ms]
+int main(int argc, char **argv){
+    if(argc < 2){
+        cerr << "Usage: " << argv[0] << " <pid> [interval in ms]" << endl;
+        return 1;
+    }
+
+    const uint64_t pid = stoull(argv[1]);
+    const chrono::milliseconds interval{argc > 2 ? stol(argv[2]) : DEFAULT_INTERVAL};
+    RenderStatus::status status;
+
+    if(!RenderStatus::read(pid, status)){
+        cerr << "The process " << pid << " does not publish a render status." << endl;
+        return 1;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "scene: " << status.scene << endl;
+    cout << "progress\ttiles\t\tMsamples/sec\telapsed (sec)\tETA (sec)\tRSS (MB)\tpeak RSS (MB)" << endl;
+
+    // The block is removed when the render ends, after the last status has been published.
+    while(RenderStatus::read(pid, status)){
+        cout << 100. * status.completedTiles / max<uint64_t>(status.totalTiles, 1) << "%\t\t"
+             << status.completedTiles << '/' << status.totalTiles << "\t\t" << status.samplesPerSecond / 1e6 << "\t\t"
+             << status.elapsed << "\t\t" << status.eta << "\t\t" << status.residentBytes / 1048576. << "\t\t"
+             << status.peakResidentBytes / 1048576. << endl;
+
+        if(status.state == RenderStatus::DONE)  break;
+        this_thread::sleep_for(interval);
+    }
+    cout << "The render has ended." << endl;
+
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include "../src/srt/geometry/shapes/AARectangle.hpp"
 #include "../src/srt/geometry/shapes/MovingSphere.hpp"
 #include "../src/srt/geometry/shapes/Sphere.hpp"
+#include "../src/srt/geometry/shapes/SphereSet.hpp"
 #include "../src/srt/geometry/instances/Translation.hpp"
 #include "../src/srt/geometry/instances/Rotation.hpp"
 #include "../src/srt/materials/Dielectric.hpp"
@@ -27,12 +28,15 @@ using namespace srt::materials;
 using namespace srt::materials::lights;
 using namespace srt::ds;
 
-Scene random_scene(const float width, const float height){
+// If motion is greater than 0, the diffuse spheres move upward up to motion units during the shot.
+// Without motion, the small spheres are stored in sets that become the leaves of the BVH.
+Scene random_scene(const float width, const float height, const float motion = 0){
     Scene scene{width, height, "result"};
     int n = 500;
     vector<shared_ptr<Hitable>> spheres;
+    SphereSet smallSpheres;
     spheres.reserve(n+1);
-    spheres.push_back(make_shared<Sphere>(Vec3{0,-1000,0}, 1000, make_shared<Lambertian>(make_shared<CheckerTexture>())));
+    spheres.push_back(scene.make<Sphere>(Vec3{0,-1000,0}, 1000, make_shared<Lambertian>(make_shared<CheckerTexture>())));
 
     for (short a = -11; a < 11; a++) {
         for (short b = -11; b < 11; b++) {
@@ -50,17 +54,22 @@ Scene random_scene(const float width, const float height){
                     material = make_shared<Dielectric>(1.5);
                 }
 
-                if(false && choose_mat < 0.8f)
-                    spheres.push_back(make_shared<MovingSphere>(center, center.multiplication(Vec3{1, 0.5f * rand_float(), 1}), 0, 1, 0.2f, material));
+                if(motion > 0 && choose_mat < 0.8f)
+                    spheres.push_back(scene.make<MovingSphere>(center, center + Vec3{0, motion * rand_float(), 0}, 0, 1, 0.2f, material));
+                else if(motion > 0)
+                    spheres.push_back(scene.make<Sphere>(center, 0.2f, material));
                 else
-                    spheres.push_back(make_shared<Sphere>(center, 0.2f, material));
+                    smallSpheres.add(center, 0.2f, material);
             }
         }
     }
 
-    spheres.push_back(make_shared<Sphere>(Vec3{0, 1, 0}, 1.0, make_shared<Dielectric>(1.5)));
-    spheres.push_back(make_shared<Sphere>(Vec3{-4, 1, 0}, 1.0, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.4, 0.2, 0.1}))));
-    spheres.push_back(make_shared<Sphere>(Vec3{4, 1, 0}, 1.0, make_shared<Metal>(Vec3{0.7, 0.6, 0.5}, 0.0)));
+    const vector<shared_ptr<Hitable>> leaves = smallSpheres.split();
+    spheres.insert(spheres.end(), leaves.begin(), leaves.end());
+
+    spheres.push_back(scene.make<Sphere>(Vec3{0, 1, 0}, 1.0, make_shared<Dielectric>(1.5)));
+    spheres.push_back(scene.make<Sphere>(Vec3{-4, 1, 0}, 1.0, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.4, 0.2, 0.1}))));
+    spheres.push_back(scene.make<Sphere>(Vec3{4, 1, 0}, 1.0, make_shared<Metal>(Vec3{0.7, 0.6, 0.5}, 0.0)));
 
     scene.addHitables(spheres);
     scene.buildBVH();
@@ -72,19 +81,18 @@ Scene my_random_scene(const float width, const float height, const size_t n, con
     uint16_t length = 1250, side = sqrt(n);
     float radius = length / (side * 2), dradius = radius * 2;
     float angularFrequency = 2 * M_PI * f;
-    vector<shared_ptr<Hitable>> objects;
-    objects.reserve(side * side);
+    SphereSet spheres;
 
     for(size_t i = 0; i < side * side; ++i){
         // Choose an x to be sure the circles are not intersected.
         float x = i / side, z = i % side;
         Vec3 pos{x * dradius, sin( x * angularFrequency) * radius, z * dradius};
         shared_ptr<Material> material = make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{1.f - (x / side), 0, 0 + (z / side)}));
-        objects.push_back(make_shared<Sphere>(pos, radius, material));
+        spheres.add(pos, radius, material);
     }
 
     // End scene.
-    scene.addHitables(objects);
+    scene.addHitables(spheres.split());
     scene.buildBVH();
     return scene;
 }
@@ -103,14 +111,14 @@ Scene BVH_scene(const float width, const float height){
     // objects.push_back(make_shared<AABox>(Vec3{250, 200, 300}, Vec3{425, 295, 465}, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
     // objects.push_back(make_shared<AABox>(Vec3{-300, -100, 50}, Vec3{300, -50, 105}, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
     
-    objects.push_back(make_shared<Sphere>(Vec3{0, 100, 500}, 50, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{200, 175, 350}, 30, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{-200, 200, 100}, 50, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{150, -30, 50}, 40, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{-180, -15, 250}, 70, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{-30, -150, 50}, 20, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{-180, -15, 550}, 105, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
-    objects.push_back(make_shared<Sphere>(Vec3{80, 15, 50}, 40, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{0, 100, 500}, 50, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{200, 175, 350}, 30, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{-200, 200, 100}, 50, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{150, -30, 50}, 40, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{-180, -15, 250}, 70, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{-30, -150, 50}, 20, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{-180, -15, 550}, 105, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
+    objects.push_back(scene.make<Sphere>(Vec3{80, 15, 50}, 40, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{rand_float()*rand_float(), rand_float()*rand_float(), rand_float()*rand_float()}))));
 
     BVH tempTree{objects, 0, 1};
     vector<shared_ptr<Hitable>> bvhSquares = tempTree.draw();
@@ -126,10 +134,10 @@ Scene light_scene(const float width, const float height){
     Scene scene{width, height, "test_light"};
     vector<shared_ptr<Hitable>> objects;
 
-    objects.push_back(make_shared<Sphere>(Vec3{0,-1000,0}, 1000, make_shared<Lambertian>(make_shared<CheckerTexture>())));
-    objects.push_back(make_shared<Sphere>(Vec3{0, 2,0}, 2, make_shared<Lambertian>(make_shared<CheckerTexture>())));
-    objects.push_back(make_shared<Sphere>(Vec3{0, 7,0}, 2, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{4, 4, 4}))));
-    objects.push_back(make_shared<AARectangle>(AARectangle::XY, 3, 5, 1, 3, -1, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{4, 4, 4}))));
+    objects.push_back(scene.make<Sphere>(Vec3{0,-1000,0}, 1000, make_shared<Lambertian>(make_shared<CheckerTexture>())));
+    objects.push_back(scene.make<Sphere>(Vec3{0, 2,0}, 2, make_shared<Lambertian>(make_shared<CheckerTexture>())));
+    objects.push_back(scene.make<Sphere>(Vec3{0, 7,0}, 2, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{4, 4, 4}))));
+    objects.push_back(scene.make<AARectangle>(AARectangle::XY, 3, 5, 1, 3, -1, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{4, 4, 4}))));
 
     scene.addHitables(objects);
     scene.buildBVH();
@@ -142,22 +150,22 @@ Scene cornell_box(const float width, const float height){
     auto white = make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.73, 0.73, 0.73}));
 
     // Right wall.
-    objects.push_back(make_shared<AARectangle>(AARectangle::YZ, 0, 555, 0, 555, 555, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.65, 0.05, 0.05})), true));
+    objects.push_back(scene.make<AARectangle>(AARectangle::YZ, 0, 555, 0, 555, 555, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.65, 0.05, 0.05})), true));
     // Left wall.
-    objects.push_back(make_shared<AARectangle>(AARectangle::YZ, 0, 555, 0, 555, 0, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.12, 0.45, 0.15}))));
+    objects.push_back(scene.make<AARectangle>(AARectangle::YZ, 0, 555, 0, 555, 0, make_shared<Lambertian>(make_shared<StaticTexture>(Vec3{0.12, 0.45, 0.15}))));
     // Front wall.
-    objects.push_back(make_shared<AARectangle>(AARectangle::XY, 0, 555, 0, 555, 555, white, true));
+    objects.push_back(scene.make<AARectangle>(AARectangle::XY, 0, 555, 0, 555, 555, white, true));
     // Roof.
-    objects.push_back(make_shared<AARectangle>(AARectangle::XZ, 0, 555, 0, 555, 555, white, true));
+    objects.push_back(scene.make<AARectangle>(AARectangle::XZ, 0, 555, 0, 555, 555, white, true));
     // Floor.
-    objects.push_back(make_shared<AARectangle>(AARectangle::XZ, 0, 555, 0, 555, 0, white));
+    objects.push_back(scene.make<AARectangle>(AARectangle::XZ, 0, 555, 0, 555, 0, white));
     // Light.
-    objects.push_back(make_shared<AARectangle>(AARectangle::XZ, 213, 343, 227, 332, 554, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{15, 15, 15})), true));
+    objects.push_back(scene.make<AARectangle>(AARectangle::XZ, 213, 343, 227, 332, 554, make_shared<DiffuseLight>(make_shared<StaticTexture>(Vec3{15, 15, 15})), true));
     // Box1.
-    objects.push_back(make_shared<Translation>(make_shared<Rotation>(Rotation::pitch, make_shared<AABox>(Vec3{0, 0, 0}, Vec3{165, 165, 165}, white), 18), Vec3{265, 0, 65}));
+    objects.push_back(scene.make<Translation>(scene.make<Rotation>(Rotation::pitch, scene.make<AABox>(Vec3{0, 0, 0}, Vec3{165, 165, 165}, white), 18), Vec3{265, 0, 65}));
     // objects.push_back(make_shared<Rotation>(Rotation::pitch, make_shared<AARectangle>( AARectangle::YZ, 0, 165, 0, 165, 165, white, true), -18));
     // Box2.
-    objects.push_back(make_shared<Translation>(make_shared<Rotation>(Rotation::pitch, make_shared<AABox>(Vec3{0, 0, 0}, Vec3{165, 330, 165}, white), -15), Vec3{130, 0, 295}));
+    objects.push_back(scene.make<Translation>(scene.make<Rotation>(Rotation::pitch, scene.make<AABox>(Vec3{0, 0, 0}, Vec3{165, 330, 165}, white), -15), Vec3{130, 0, 295}));
 
     scene.addHitables(objects);
     scene.buildBVH();
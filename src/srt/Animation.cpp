@@ -0,0 +1,180 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  ANIMATION CLASS FILE                               *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "Animation.hpp"
+
+// System includes.
+#include <algorithm>
+
+// My includes.
+#include "utility/Profiler.hpp"
+#include "utility/Stopwatch.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+using namespace srt::geometry::instances;
+
+namespace srt{
+
+    /**
+     * @brief Constructs a new Animation object without keyframes.
+     *
+     * @param first - The first frame to render.
+     * @param last - The last frame to render.
+     * @param shutter - The fraction of a frame during which the camera is open.
+     * @param threshold - The ratio between the cost of the refitted BVH and the cost of the built one
+     *                    over which the BVH is built again.
+     */
+    Animation::Animation(const float first, const float last, const float shutter, const float threshold) :
+        first(first), last(last), shutter(shutter), threshold(threshold) { }
+
+    /**
+     * @brief Returns the first frame to render.
+     *
+     * @return float - The frame.
+     */
+    float Animation::getFirstFrame() const{
+        return this->first;
+    }
+
+    /**
+     * @brief Returns the last frame to render.
+     *
+     * @return float - The frame.
+     */
+    float Animation::getLastFrame() const{
+        return this->last;
+    }
+
+    /**
+     * @brief Tells if there is more than one frame to render.
+     *
+     * @return true - If the last frame comes after the first one.
+     * @return false - Otherwise.
+     */
+    bool Animation::isAnimated() const{
+        return this->last > this->first;
+    }
+
+    /**
+     * @brief Tells if the animation does nothing: one frame and no keyframes.
+     *
+     * @return true - If the scene is the same whatever frame is rendered.
+     * @return false - Otherwise.
+     */
+    bool Animation::isStill() const{
+        return !this->isAnimated() && this->cameraKeys.empty() && this->tracks.empty();
+    }
+
+    /**
+     * @brief Adds a keyframe of the camera.
+     *
+     * @param frame - The frame.
+     * @param camera - The camera at that frame.
+     */
+    void Animation::addCameraKey(const float frame, const Camera::settings &camera){
+        const auto position = upper_bound(this->cameraKeys.begin(), this->cameraKeys.end(), frame,
+                                          [](const float f, const camera_key &key){ return f < key.frame; });
+        this->cameraKeys.insert(position, {frame, camera});
+    }
+
+    /**
+     * @brief Animates the offset of a translation.
+     *
+     * @param translation - The translation, that must be in the scene.
+     * @param keys - The offsets at some frames, in any order.
+     */
+    void Animation::addTrack(const shared_ptr<Translation> &translation, const vector<offset_key> &keys){
+        if(!keys.empty())   this->tracks.push_back({translation, nullptr, sorted(keys)});
+    }
+
+    /**
+     * @brief Animates the offsets of a moving translation, that moves the object during the shutter.
+     *        Its times must be the ones of the camera.
+     *
+     * @param movingTranslation - The moving translation, that must be in the scene.
+     * @param keys - The offsets at some frames, in any order.
+     */
+    void Animation::addTrack(const shared_ptr<MovingTranslation> &movingTranslation, const vector<offset_key> &keys){
+        if(!keys.empty())   this->tracks.push_back({nullptr, movingTranslation, sorted(keys)});
+    }
+
+    /**
+     * @brief Returns the camera at a frame, interpolating the keyframes around it.
+     *
+     * @param frame - The frame.
+     * @param still - The camera returned if there are no keyframes of the camera.
+     * @return Camera::settings - The camera.
+     */
+    Camera::settings Animation::getCamera(const float frame, const Camera::settings &still) const{
+        if(this->cameraKeys.empty())                    return still;
+        if(frame <= this->cameraKeys.front().frame)     return this->cameraKeys.front().camera;
+        if(frame >= this->cameraKeys.back().frame)      return this->cameraKeys.back().camera;
+
+        const auto next = upper_bound(this->cameraKeys.begin(), this->cameraKeys.end(), frame,
+                                      [](const float f, const camera_key &key){ return f < key.frame; });
+        const Camera::settings &c0 = (next - 1)->camera, &c1 = next->camera;
+        const float alpha = (frame - (next - 1)->frame) / (next->frame - (next - 1)->frame);
+        const auto mix = [alpha](const float a, const float b){ return a + alpha * (b - a); };
+
+        return {c0.lookFrom + alpha * (c1.lookFrom - c0.lookFrom), c0.lookAt + alpha * (c1.lookAt - c0.lookAt),
+                c0.up + alpha * (c1.up - c0.up), mix(c0.vfov, c1.vfov), mix(c0.aperture, c1.aperture),
+                mix(c0.focus, c1.focus), mix(c0.t0, c1.t0), mix(c0.t1, c1.t1)};
+    }
+
+    /**
+     * @brief Moves the objects of the scene at a frame and updates its BVH.
+     *
+     * @param scene - The scene, whose BVH has been built.
+     * @param frame - The frame.
+     * @return frame_stats - If the BVH has been built again, its cost ratio and the time taken.
+     */
+    Animation::frame_stats Animation::setFrame(Scene &scene, const float frame) const{
+        utility::Profiler::Zone zone{"frame setup"};
+        utility::Stopwatch sw;
+        sw.start();
+
+        for(const track &t : this->tracks){
+            const Vec3 offset = interpolate(t.keys, frame);
+            if(t.translation != nullptr)    t.translation->setOffset(offset);
+            else                            t.movingTranslation->setOffsets(offset, interpolate(t.keys, frame + this->shutter));
+        }
+
+        const bool rebuilt = !this->tracks.empty() && scene.refitBVH(this->threshold);
+        return {rebuilt, scene.getHierarchyCostRatio(), sw.end()};
+    }
+
+    /**
+     * @brief Interpolates the offsets of a track at a frame.
+     *
+     * @param keys - The keys, sorted by frame.
+     * @param frame - The frame.
+     * @return Vec3 - The offset.
+     */
+    Vec3 Animation::interpolate(const vector<offset_key> &keys, const float frame){
+        if(frame <= keys.front().frame)     return keys.front().offset;
+        if(frame >= keys.back().frame)      return keys.back().offset;
+
+        const auto next = upper_bound(keys.begin(), keys.end(), frame, [](const float f, const offset_key &key){ return f < key.frame; });
+        const float alpha = (frame - (next - 1)->frame) / (next->frame - (next - 1)->frame);
+        return (next - 1)->offset + alpha * (next->offset - (next - 1)->offset);
+    }
+
+    /**
+     * @brief Sorts the keys of a track by frame.
+     *
+     * @param keys - The keys.
+     * @return vector<offset_key> - The sorted keys.
+     */
+    vector<Animation::offset_key> Animation::sorted(vector<offset_key> keys){
+        stable_sort(keys.begin(), keys.end(), [](const offset_key &a, const offset_key &b){ return a.frame < b.frame; });
+        return keys;
+    }
+
+}
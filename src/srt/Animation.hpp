@@ -0,0 +1,97 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  ANIMATION HEADER FILE                              *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_ANIMATION_S
+#define S_ANIMATION_S
+
+// System includes.
+#include <memory>
+#include <vector>
+
+// My includes.
+#include "Camera.hpp"
+#include "Scene.hpp"
+#include "geometry/instances/Translation.hpp"
+#include "geometry/instances/MovingTranslation.hpp"
+
+namespace srt{
+
+/// The keyframes of an animation: the camera and the offsets of some translations at some frames,
+/// linearly interpolated between them. Setting a frame moves the objects and updates the BVH of
+/// the scene: since the objects are the same, the BVH is refitted, and it is built again only when
+/// the refitted tree costs more than the threshold times the tree built.
+/// The tracks of the moving translations give their offsets at the start of the frame and after
+/// the shutter, that is a fraction of a frame, so that they are blurred by the camera.
+class Animation{
+public:
+    // CONSTANTS
+
+    static constexpr float REBUILD_THRESHOLD = 1.5;
+
+    // STRUCTURES
+
+    typedef struct ck{
+        float frame;
+        Camera::settings camera;
+    } camera_key;
+
+    typedef struct ok{
+        float frame;
+        geometry::Vec3 offset;
+    } offset_key;
+
+    /// What setting a frame has done, and in how much time.
+    typedef struct fs{
+        bool rebuilt;
+        float costRatio;
+        double setupTime;
+    } frame_stats;
+
+private:
+    // STRUCTURES
+
+    typedef struct tr{
+        std::shared_ptr<geometry::instances::Translation> translation;
+        std::shared_ptr<geometry::instances::MovingTranslation> movingTranslation;
+        std::vector<offset_key> keys;
+    } track;
+
+    // ATTRIBUTES
+
+    float first, last, shutter, threshold;
+    std::vector<camera_key> cameraKeys;
+    std::vector<track> tracks;
+
+    // METHODS
+
+    static geometry::Vec3 interpolate(const std::vector<offset_key> &keys, const float frame);
+    static std::vector<offset_key> sorted(std::vector<offset_key> keys);
+
+public:
+    // CONSTRUCTORS
+
+    Animation(const float first = 0, const float last = 0, const float shutter = 0, const float threshold = REBUILD_THRESHOLD);
+
+    // METHODS
+
+    float getFirstFrame() const;
+    float getLastFrame() const;
+    bool isAnimated() const;
+    bool isStill() const;
+    void addCameraKey(const float frame, const Camera::settings &camera);
+    void addTrack(const std::shared_ptr<geometry::instances::Translation> &translation, const std::vector<offset_key> &keys);
+    void addTrack(const std::shared_ptr<geometry::instances::MovingTranslation> &movingTranslation,
+                  const std::vector<offset_key> &keys);
+    Camera::settings getCamera(const float frame, const Camera::settings &still) const;
+    frame_stats setFrame(Scene &scene, const float frame) const;
+};
+
+}
+
+#endif
@@ -36,7 +36,7 @@ namespace srt{
     Camera::Camera(const Vec3 &lookFrom, const Vec3 &lookAt, const Vec3 &up, const float vfov, 
             const float aspect, const float aperture, const float focusDist, const float t0, const float t1) : 
             origin(lookFrom), aperture(aperture / 2), t0(t0 > 0 ? t0 : 0), t1(t1 > t0 ? t1 : t0){
-        Vec3 w = (lookFrom - lookAt).normalize();
+        this->w = (lookFrom - lookAt).normalize();
         this->u = w.cross(up).normalize();
         this->v = this->u.cross(w).normalize();
         float theta = vfov * M_PI / 180.;
@@ -56,13 +56,35 @@ namespace srt{
      * @param t - The vertical offset.
      * @return Ray - The ray from the camera to the scene.
      */
-    Ray Camera::get_ray(const float s, const float t){
+    Ray Camera::get_ray(const float s, const float t) const{
         Vec3 start = this->aperture * Randomizer::randomInUnitSphere();
         Vec3 offset = this->u * start.x() + this->v * start.y();
         float time = Randomizer::randomRange(this->t0, this->t1);
         return {this->origin + offset, this->lower_left_corner + s * this->horizontal + t * this->vertical - origin - offset, time};
     }
 
+    /**
+     * @brief Finds the offsets of the ray from the center of the lens that passes through a point,
+     *        the inverse of get_ray. The offsets are in [0, 1] if the point is in the image.
+     * 
+     * @param point - The point.
+     * @param s - Set to the horizontal offset.
+     * @param t - Set to the vertical offset.
+     * @return true - If the point is in front of the camera.
+     * @return false - Otherwise, and the offsets are not set.
+     */
+    bool Camera::project(const Vec3 &point, float &s, float &t) const{
+        const Vec3 direction = point - this->origin, corner = this->lower_left_corner - this->origin;
+        const float depth = -(direction * this->w);
+        if(depth <= 0)  return false;
+
+        // Where the direction crosses the plane of the image, from its corner.
+        const Vec3 onImage = direction * (-(corner * this->w) / depth) - corner;
+        s = (onImage * this->horizontal) / (this->horizontal * this->horizontal);
+        t = (onImage * this->vertical) / (this->vertical * this->vertical);
+        return true;
+    }
+
     /**
      * @brief Set the new camera time. If t0 is negative, it will not be changed. 
      *        If t1 is less than t0, it will not be changed.
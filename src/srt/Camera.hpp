@@ -18,10 +18,19 @@ namespace srt{
 
 /// This class represents the camera from which see the scene.
 class Camera{
+public:
+    // STRUCTURES
+
+    /// The arguments of a camera but the aspect ratio, that depends on the image.
+    typedef struct st{
+        geometry::Vec3 lookFrom, lookAt, up;
+        float vfov, aperture, focus, t0, t1;
+    } settings;
+
 private:
     // ATTRIBUTES
 
-    geometry::Vec3 origin, lower_left_corner, horizontal, vertical, u, v;
+    geometry::Vec3 origin, lower_left_corner, horizontal, vertical, u, v, w;
     float aperture, t0, t1;
 public:
     // CONSTRUCTORS
@@ -32,7 +41,8 @@ public:
 
     // METHODS
 
-    Ray get_ray(const float u, const float v);
+    Ray get_ray(const float u, const float v) const;
+    bool project(const geometry::Vec3 &point, float &s, float &t) const;
     void setTime(const float t0, const float t1);
 };
 
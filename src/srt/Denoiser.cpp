@@ -0,0 +1,130 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  DENOISER CLASS FILE                                *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "Denoiser.hpp"
+
+// System includes.
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// My includes.
+#include "utility/Profiler.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+
+// The albedo under which a channel is not divided.
+const float MIN_ALBEDO = 1e-3;
+// The weights of the pixels of the filter by their distance, a B3 spline.
+const float KERNEL[5] = {1 / 16.f, 1 / 4.f, 3 / 8.f, 1 / 4.f, 1 / 16.f};
+// The weights of the channels in the luminance.
+const srt::geometry::Vec3 LUMINANCE{0.2126, 0.7152, 0.0722};
+
+namespace srt{
+
+    /**
+     * @brief Constructs a new Denoiser object for the images of a size.
+     *
+     * @param width - The width in pixel of the images.
+     * @param height - The height in pixel of the images.
+     * @param settings - The passes of the filter and the spread of its weights.
+     */
+    Denoiser::Denoiser(const size_t width, const size_t height, const parameters &settings) :
+        width(width), height(height), settings(settings){
+        if(settings.passes < 0 || settings.albedo <= 0 || settings.normal <= 0 || settings.depth <= 0 || settings.color <= 0)
+            throw invalid_argument("The passes of the denoiser must not be negative and its sigmas must be positive");
+    }
+
+    /**
+     * @brief Filters an image with its features.
+     *
+     * @param color - The linear colors of the pixels, row by row.
+     * @param features - The features of the pixels, in the same order.
+     * @return std::vector<geometry::Vec3> - The filtered colors.
+     */
+    std::vector<Vec3> Denoiser::denoise(const std::vector<Vec3> &color, const feature_buffers &features) const{
+        utility::Profiler::Zone zone{"denoise"};
+        const size_t size = this->width * this->height;
+        if(color.size() != size || features.albedo.size() != size || features.normal.size() != size || features.depth.size() != size)
+            throw invalid_argument("The image and its features must have a value for every pixel");
+
+        // Divide the color by the albedo, the channels without albedo are left as they are.
+        std::vector<Vec3> albedo(size), light(size), result(size);
+        for(size_t i = 0; i < size; ++i){
+            const Vec3 &a = features.albedo[i];
+            albedo[i] = {a.x() > MIN_ALBEDO ? a.x() : 1, a.y() > MIN_ALBEDO ? a.y() : 1, a.z() > MIN_ALBEDO ? a.z() : 1};
+            light[i] = color[i] / albedo[i];
+        }
+
+        float colorSigma = this->settings.color;
+        for(int pass = 0; pass < this->settings.passes; ++pass, colorSigma /= 2){
+            this->filter(light, result, features, 1 << pass, colorSigma);
+            light.swap(result);
+        }
+
+        for(size_t i = 0; i < size; ++i)
+            result[i] = light[i].multiplication(albedo[i]);
+        return result;
+    }
+
+    /**
+     * @brief Applies a pass of the filter, on the pixels at a distance from each other.
+     *
+     * @param light - The light of the pixels, their color divided by their albedo.
+     * @param result - Set to the filtered light.
+     * @param features - The features of the pixels.
+     * @param step - The distance between the pixels of the filter.
+     * @param colorSigma - The sigma of the luminance in this pass.
+     */
+    void Denoiser::filter(const std::vector<Vec3> &light, std::vector<Vec3> &result, const feature_buffers &features,
+                          const int step, const float colorSigma) const{
+        const long width = this->width, height = this->height;
+        const float albedoFactor = 1 / (2 * this->settings.albedo * this->settings.albedo),
+                    normalFactor = 1 / (2 * this->settings.normal * this->settings.normal),
+                    depthFactor = 1 / (2 * this->settings.depth * this->settings.depth),
+                    colorFactor = 1 / (2 * colorSigma * colorSigma);
+
+        #pragma omp parallel for
+        for(long y = 0; y < height; ++y){
+            for(long x = 0; x < width; ++x){
+                const size_t p = y * width + x;
+                const Vec3 &albedoP = features.albedo[p], &normalP = features.normal[p];
+                const float depthP = features.depth[p], luminanceP = light[p] * LUMINANCE;
+                Vec3 sum;
+                float weights = 0;
+
+                for(int dy = -2; dy <= 2; ++dy){
+                    const long qy = y + dy * step;
+                    if(qy < 0 || qy >= height)  continue;
+
+                    for(int dx = -2; dx <= 2; ++dx){
+                        const long qx = x + dx * step;
+                        if(qx < 0 || qx >= width)   continue;
+
+                        const size_t q = qy * width + qx;
+                        const Vec3 albedoDiff = features.albedo[q] - albedoP, normalDiff = features.normal[q] - normalP;
+                        const float farther = max(depthP, features.depth[q]),
+                                    depthDiff = farther > 0 ? (features.depth[q] - depthP) / farther : 0,
+                                    luminanceDiff = light[q] * LUMINANCE - luminanceP;
+                        const float weight = KERNEL[dx + 2] * KERNEL[dy + 2] * 
+                                             exp(-(albedoDiff * albedoDiff) * albedoFactor - (normalDiff * normalDiff) * normalFactor
+                                                 - depthDiff * depthDiff * depthFactor - luminanceDiff * luminanceDiff * colorFactor);
+                        sum += weight * light[q];
+                        weights += weight;
+                    }
+                }
+
+                // The pixel itself has a positive weight, so the sum of the weights is never 0.
+                result[p] = sum / weights;
+            }
+        }
+    }
+
+}
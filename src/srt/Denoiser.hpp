@@ -0,0 +1,78 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  DENOISER HEADER FILE                               *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_DENOISER_S
+#define S_DENOISER_S
+
+// System includes.
+#include <vector>
+
+// My includes.
+#include "geometry/Vec3.hpp"
+
+namespace srt{
+
+/// A joint bilateral filter that removes the noise of an image rendered with few samples, guided
+/// by the features of the first hits of its pixels: the albedo, the normal and the depth.
+/// Every pixel becomes the average of the pixels around it, weighted by their distance and by how
+/// much their features and their colors differ, so that the edges of the objects and of the materials
+/// are kept. The filter is applied many times on 5x5 pixels that are 1, 2, 4... pixels apart
+/// (a trous), so that a large area is covered with few pixels; the weight of the colors gets
+/// stricter at every pass, as the noise goes away.
+/// The color is divided by the albedo before filtering and multiplied again after, so that only
+/// the light is blurred and the textures stay sharp. The rows are filtered by many threads.
+class Denoiser{
+public:
+    // CONSTANTS
+
+    static constexpr int PASSES = 5;
+    static constexpr float SIGMA_ALBEDO = 0.1, SIGMA_NORMAL = 0.3, SIGMA_DEPTH = 0.05, SIGMA_COLOR = 2;
+
+    // STRUCTURES
+
+    /// The features of the first hits of the pixels, averaged on their samples. A ray that hits nothing
+    /// has depth 0, a null normal and the color of the background as albedo; a light has its emission.
+    typedef struct fb{
+        std::vector<geometry::Vec3> albedo, normal;
+        std::vector<float> depth;
+    } feature_buffers;
+
+    /// The passes of the filter and how fast the weight of a pixel falls with the difference of its
+    /// features and of the luminance of its light. The depth is compared relatively to the farther one,
+    /// the luminance with a sigma halved at every pass.
+    typedef struct pr{
+        int passes;
+        float albedo, normal, depth, color;
+    } parameters;
+
+private:
+    // ATTRIBUTES
+
+    size_t width, height;
+    parameters settings;
+
+    // METHODS
+
+    void filter(const std::vector<geometry::Vec3> &light, std::vector<geometry::Vec3> &result, const feature_buffers &features,
+                const int step, const float colorSigma) const;
+
+public:
+    // CONSTRUCTORS
+
+    Denoiser(const size_t width, const size_t height,
+             const parameters &settings = {PASSES, SIGMA_ALBEDO, SIGMA_NORMAL, SIGMA_DEPTH, SIGMA_COLOR});
+
+    // METHODS
+
+    std::vector<geometry::Vec3> denoise(const std::vector<geometry::Vec3> &color, const feature_buffers &features) const;
+};
+
+}
+
+#endif
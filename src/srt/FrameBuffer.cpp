@@ -0,0 +1,300 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  FRAME BUFFER CLASS FILE                            *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "FrameBuffer.hpp"
+
+// System includes.
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace srt::geometry;
+
+// The first line of a file written by FrameBuffer::write.
+const string MAGIC = "SRTL 1";
+
+namespace srt{
+
+    const char *const FrameBuffer::NAMES[CHANNELS] = {"beauty", "direct", "indirect", "emission", "albedo", "normal",
+                                                      "depth", "object_id", "material_id"};
+    const uint32_t FrameBuffer::COMPONENTS[CHANNELS] = {3, 3, 3, 3, 3, 3, 1, 1, 1};
+
+    /**
+     * @brief Constructs a new FrameBuffer object without pixels nor channels.
+     *
+     */
+    FrameBuffer::FrameBuffer() : FrameBuffer(0, 0, 0){}
+
+    /**
+     * @brief Constructs a new FrameBuffer object with some channels, black.
+     *
+     * @param width - The width in pixel of the images.
+     * @param height - The height in pixel of the images.
+     * @param mask - The enabled channels, the bit 1 << channel for every one.
+     */
+    FrameBuffer::FrameBuffer(const size_t width, const size_t height, const uint32_t mask) :
+        width(width), height(height), mask(mask), channels(CHANNELS){
+        if(mask >> CHANNELS != 0)
+            throw invalid_argument("The frame buffer has only " + to_string(CHANNELS) + " channels");
+
+        for(uint32_t c = 0; c < CHANNELS; ++c){
+            if(this->isEnabled(static_cast<Channel>(c))){
+                this->enabled.push_back(static_cast<Channel>(c));
+                this->channels[c].resize(width * height);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the width of the images.
+     *
+     * @return const size_t& - The width in pixel.
+     */
+    const size_t &FrameBuffer::getWidth() const{
+        return this->width;
+    }
+
+    /**
+     * @brief Returns the height of the images.
+     *
+     * @return const size_t& - The height in pixel.
+     */
+    const size_t &FrameBuffer::getHeight() const{
+        return this->height;
+    }
+
+    /**
+     * @brief Returns the enabled channels.
+     *
+     * @return const uint32_t& - The bit 1 << channel for every enabled channel.
+     */
+    const uint32_t &FrameBuffer::getMask() const{
+        return this->mask;
+    }
+
+    /**
+     * @brief Tells if a channel is kept by the buffer.
+     *
+     * @param channel - The channel.
+     * @return true - If it is enabled.
+     * @return false - Otherwise.
+     */
+    bool FrameBuffer::isEnabled(const Channel channel) const{
+        return isEnabled(this->mask, channel);
+    }
+
+    /**
+     * @brief Tells if a channel is in a mask, for the integrator that writes the channels of a path.
+     *
+     * @param mask - The bit 1 << channel for every enabled channel.
+     * @param channel - The channel.
+     * @return true - If it is enabled.
+     * @return false - Otherwise.
+     */
+    bool FrameBuffer::isEnabled(const uint32_t mask, const Channel channel){
+        return (mask >> channel) & 1;
+    }
+
+    /**
+     * @brief Tells if a channel holds ids, which are not averaged.
+     *
+     * @param channel - The channel.
+     * @return true - If it is the object or the material id.
+     * @return false - Otherwise.
+     */
+    bool FrameBuffer::isId(const Channel channel){
+        return channel == OBJECT_ID || channel == MATERIAL_ID;
+    }
+
+    /**
+     * @brief Returns the image of a channel.
+     *
+     * @param channel - The channel, that must be enabled.
+     * @return const std::vector<geometry::Vec3>& - The values of the pixels, row by row from the top.
+     */
+    const std::vector<Vec3> &FrameBuffer::getChannel(const Channel channel) const{
+        if(channel >= CHANNELS || !this->isEnabled(channel))
+            throw invalid_argument("The channel is not enabled");
+        return this->channels[channel];
+    }
+
+    /**
+     * @brief Adds a path to the sum of the paths of a pixel, in the enabled channels. The ids are taken
+     *        from the first path.
+     *
+     * @param sum - The sum of the previous paths of the pixel.
+     * @param path - The values of the path.
+     */
+    void FrameBuffer::add(sample &sum, const sample &path) const{
+        for(const Channel c : this->enabled){
+            if(!isId(c))
+                sum.values[c] += path.values[c];
+            else if(sum.paths == 0)
+                sum.values[c] = path.values[c];
+        }
+        ++sum.paths;
+    }
+
+    /**
+     * @brief Sets a pixel to the average of its paths, in the enabled channels.
+     *
+     * @param pixel - The index of the pixel, row by row from the top.
+     * @param sum - The sum of the paths of the pixel, made by add().
+     */
+    void FrameBuffer::set(const size_t pixel, const sample &sum){
+        const float paths = sum.paths > 0 ? sum.paths : 1;
+        for(const Channel c : this->enabled)
+            this->channels[c][pixel] = isId(c) ? sum.values[c] : sum.values[c] / paths;
+    }
+
+    /**
+     * @brief Writes every enabled channel in a Portable Float Map, <prefix>_<channel>.pfm: a color one
+     *        for the channels with three values and a grey one for the others.
+     *
+     * @param prefix - The path of the files, without the channel.
+     */
+    void FrameBuffer::writePFM(const std::string &prefix) const{
+        for(uint32_t c = 0; c < CHANNELS; ++c){
+            if(!this->isEnabled(static_cast<Channel>(c)))  continue;
+
+            const string path = prefix + "_" + NAMES[c] + ".pfm";
+            ofstream file(path, ios::out | ios::trunc | ios::binary);
+            if(!file)
+                throw invalid_argument("The file " + path + " cannot be written");
+
+            // A negative scale tells that the floats are little endian; the rows go from the bottom.
+            file << (COMPONENTS[c] == 3 ? "PF" : "Pf") << '\n' << this->width << ' ' << this->height << "\n-1.0\n";
+            for(size_t row = this->height; row > 0; --row)
+                for(size_t i = (row - 1) * this->width; i < row * this->width; ++i){
+                    const float values[3] = {this->channels[c][i].x(), this->channels[c][i].y(), this->channels[c][i].z()};
+                    file.write(reinterpret_cast<const char *>(values), COMPONENTS[c] * sizeof(float));
+                }
+            if(!file)
+                throw runtime_error("Cannot write the file " + path);
+        }
+    }
+
+    /**
+     * @brief Writes the enabled channels in a single file, as layers. The file starts with a text header:
+     *        "SRTL 1", the width, the height and the number of layers, and a line with the name and the
+     *        values per pixel of every layer; the layers follow, one after the other, as floats in the byte
+     *        order of the machine, row by row from the top.
+     *
+     * @param path - The path of the file.
+     */
+    void FrameBuffer::write(const std::string &path) const{
+        ofstream file(path, ios::out | ios::trunc | ios::binary);
+        if(!file)
+            throw invalid_argument("The file " + path + " cannot be written");
+
+        uint32_t layers = 0;
+        for(uint32_t c = 0; c < CHANNELS; ++c)
+            layers += this->isEnabled(static_cast<Channel>(c));
+        file << MAGIC << '\n' << this->width << ' ' << this->height << ' ' << layers << '\n';
+        for(uint32_t c = 0; c < CHANNELS; ++c)
+            if(this->isEnabled(static_cast<Channel>(c)))
+                file << NAMES[c] << ' ' << COMPONENTS[c] << '\n';
+
+        for(uint32_t c = 0; c < CHANNELS; ++c)
+            if(this->isEnabled(static_cast<Channel>(c)))
+                for(const Vec3 &value : this->channels[c]){
+                    const float values[3] = {value.x(), value.y(), value.z()};
+                    file.write(reinterpret_cast<const char *>(values), COMPONENTS[c] * sizeof(float));
+                }
+        if(!file)
+            throw runtime_error("Cannot write the file " + path);
+    }
+
+    /**
+     * @brief Turns a list of channels into the mask of the buffer.
+     *
+     * @param names - The names of the channels, separated by commas, for example "albedo,normal".
+     * @return uint32_t - The bit 1 << channel for every channel in the list.
+     */
+    uint32_t FrameBuffer::parse(const std::string &names){
+        uint32_t mask = 0;
+        stringstream list(names);
+        string name;
+
+        while(getline(list, name, ',')){
+            if(name.empty())    continue;
+            uint32_t c = 0;
+            while(c < CHANNELS && name != NAMES[c])
+                ++c;
+            if(c == CHANNELS)
+                throw invalid_argument("Unknown output variable " + name);
+            mask |= 1 << c;
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Computes the id of the primitive that has been hit: a hash of the object and of its part,
+     *        from 1 to 2^24 so that a float holds it exactly; 0 is left to the rays that hit nothing.
+     *        The id is the same for the same primitive during a run, not between two runs.
+     *
+     * @param record - The hit.
+     * @return float - The id of the primitive.
+     */
+    float FrameBuffer::objectId(const Hitable::hit_record &record){
+        // The finalizer of splitmix64, so that near addresses give far ids.
+        uint64_t key = reinterpret_cast<uintptr_t>(record.object) ^ (static_cast<uint64_t>(record.index) << 40);
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<float>((key & 0xffffff) + 1);
+    }
+
+    /**
+     * @brief Reads a file written by write().
+     *
+     * @param path - The path of the file.
+     * @return FrameBuffer - A buffer with the channels of the file enabled.
+     */
+    FrameBuffer FrameBuffer::read(const std::string &path){
+        ifstream file(path, ios::in | ios::binary);
+        string magic;
+        if(!file || !getline(file, magic) || magic != MAGIC)
+            throw invalid_argument("The file " + path + " is not a layered image");
+
+        size_t width, height;
+        uint32_t layers;
+        if(!(file >> width >> height >> layers))
+            throw invalid_argument("The file " + path + " is truncated");
+
+        vector<uint32_t> order;
+        uint32_t mask = 0;
+        for(uint32_t l = 0; l < layers; ++l){
+            string name;
+            uint32_t components;
+            if(!(file >> name >> components))
+                throw invalid_argument("The file " + path + " is truncated");
+            uint32_t c = 0;
+            while(c < CHANNELS && name != NAMES[c])
+                ++c;
+            if(c == CHANNELS || ((mask >> c) & 1) || components != COMPONENTS[c])
+                throw invalid_argument("The file " + path + " has a wrong layer " + name);
+            mask |= 1 << c;
+            order.push_back(c);
+        }
+        file.ignore(1);
+
+        FrameBuffer buffer{width, height, mask};
+        for(const uint32_t c : order)
+            for(Vec3 &value : buffer.channels[c]){
+                float values[3] = {0, 0, 0};
+                if(!file.read(reinterpret_cast<char *>(values), COMPONENTS[c] * sizeof(float)))
+                    throw invalid_argument("The file " + path + " is truncated");
+                value = {values[0], values[1], values[2]};
+            }
+        return buffer;
+    }
+
+}
@@ -0,0 +1,91 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  FRAME BUFFER HEADER FILE                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_FRAMEBUFFER_S
+#define S_FRAMEBUFFER_S
+
+// System includes.
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// My includes.
+#include "Hitable.hpp"
+#include "geometry/Vec3.hpp"
+
+namespace srt{
+
+/// The images of a render, one for every output variable (AOV) asked: the beauty, its parts and
+/// the features of the first hits. The integrator writes the enabled channels of a path in a sample,
+/// the samples are summed for every pixel and the buffer keeps only the enabled channels, so a
+/// disabled channel takes no memory nor time; when no channel is enabled the integrator is given
+/// no sample and writes nothing.
+/// The light of a path is in one of EMISSION (the lights and the background seen from the camera),
+/// DIRECT (the light that reaches the camera after one bounce) or INDIRECT (after two or more), so
+/// they sum to the beauty. The ids are not averaged: a pixel has the ones of its first path.
+class FrameBuffer{
+public:
+    // CONSTANTS
+
+    /// The output variables.
+    enum Channel : uint32_t {BEAUTY, DIRECT, INDIRECT, EMISSION, ALBEDO, NORMAL, DEPTH, OBJECT_ID, MATERIAL_ID, CHANNELS};
+
+    static const char *const NAMES[CHANNELS];
+    /// The values of a pixel in a channel: three for the colors and the normals, one for the others.
+    static const uint32_t COMPONENTS[CHANNELS];
+    static constexpr const char *EXTENSION = ".srtl";
+
+    // STRUCTURES
+
+    /// The values of the channels of a path, or their sum on the paths of a pixel. The one-component
+    /// channels use the first component, and only the enabled channels are meaningful.
+    typedef struct sm{
+        geometry::Vec3 values[CHANNELS];
+        uint32_t paths = 0;
+    } sample;
+
+private:
+    // ATTRIBUTES
+
+    size_t width, height;
+    uint32_t mask;
+    std::vector<Channel> enabled;
+    std::vector<std::vector<geometry::Vec3>> channels;
+
+    // METHODS
+
+    static bool isId(const Channel channel);
+
+public:
+    // CONSTRUCTORS
+
+    FrameBuffer();
+    FrameBuffer(const size_t width, const size_t height, const uint32_t mask);
+
+    // METHODS
+
+    const size_t &getWidth() const;
+    const size_t &getHeight() const;
+    const uint32_t &getMask() const;
+    bool isEnabled(const Channel channel) const;
+    const std::vector<geometry::Vec3> &getChannel(const Channel channel) const;
+    void add(sample &sum, const sample &path) const;
+    void set(const size_t pixel, const sample &sum);
+    void writePFM(const std::string &prefix) const;
+    void write(const std::string &path) const;
+
+    static bool isEnabled(const uint32_t mask, const Channel channel);
+    static uint32_t parse(const std::string &names);
+    static float objectId(const Hitable::hit_record &record);
+    static FrameBuffer read(const std::string &path);
+};
+
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "structs.h"
 #include "Ray.hpp"
 #include "materials/Material.hpp"
+#include "materials/MaterialTable.hpp"
 #include "geometry/AABB.hpp"
 
 namespace srt{
@@ -27,7 +28,8 @@ public:
     // STRUCTURES
 
     /**
-     * @brief It stores the info about the collision with a ray.
+     * @brief It stores the info about the collision with a ray. The index identifies the part of 
+     *        the object that has been hit, for the objects made of many parts.
      * 
      */
     typedef struct hr{
@@ -35,9 +37,11 @@ public:
         float t;
         Hitable const* object;
         geometry::Vec3 point, normal;
+        uint32_t materialId, index;
         
-        hr(bool h, float t, Hitable const *obj, const geometry::Vec3 &point, const geometry::Vec3 &normal) : 
-            hit(h), t(t), object(obj), point(point), normal(normal) {}
+        hr(bool h, float t, Hitable const *obj, const geometry::Vec3 &point, const geometry::Vec3 &normal, 
+           const uint32_t materialId = materials::MaterialTable::NO_MATERIAL_ID, const uint32_t index = 0) : 
+            hit(h), t(t), object(obj), point(point), normal(normal), materialId(materialId), index(index) {}
     } hit_record;
 
     // The record for no hit situation.
@@ -65,6 +69,15 @@ public:
         return NO_MATERIAL;
     }
 
+    /**
+     * @brief Adds the materials of the object to the table of the scene, and stores their ids
+     *        so that they are returned in the hit records. The materials are interned: the object
+     *        must keep the instances returned by MaterialTable::intern in place of its own.
+     * 
+     * @param table - The table of the materials.
+     */
+    virtual void bindMaterials(materials::MaterialTable &table){ }
+
     /**
      * @brief Returns the axis aligned bounded box boxes.
      * 
@@ -78,10 +91,12 @@ public:
      * @brief Get the Texture Coords of the object  in a given point.
      * 
      * @param p - The hit point on the object.
-     * @return geometry::Vec3 - The texture coords.
+     * @param index - The index of the part hit, as returned in the hit record.
+     * @return geometry::Vec3 - The texture coords in x and y. The z stores the texture scale, that is how 
+     *                          much the texture coords change moving by a unit on the surface (0 if unknown). 
      */
-    virtual geometry::Vec3 getTextureCoords(const srt::geometry::Vec3 &p) const {
-        return p;
+    virtual geometry::Vec3 getTextureCoords(const srt::geometry::Vec3 &p, const uint32_t index = 0) const {
+        return {p.x(), p.y(), 0};
     }
 
     // OPERATORS
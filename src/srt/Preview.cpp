@@ -0,0 +1,165 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PREVIEW CLASS FILE                                 *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "srt.h"
+#include "Preview.hpp"
+
+// System includes.
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// My includes.
+#include "utility/Profiler.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+
+namespace srt{
+
+    /**
+     * @brief Constructs a new Preview object, whose first frame starts from scratch.
+     *
+     * @param width - The width in pixel of the preview.
+     * @param height - The height in pixel of the preview.
+     */
+    Preview::Preview(const size_t width, const size_t height) :
+        width(width), height(height), pixels(width * height), history(width * height), settings(), started(false){
+        if(width == 0 || height == 0)
+            throw invalid_argument("The preview must have at least one pixel");
+    }
+
+    /**
+     * @brief Returns the width of the preview.
+     *
+     * @return const size_t& - The width in pixel.
+     */
+    const size_t &Preview::getWidth() const{
+        return this->width;
+    }
+
+    /**
+     * @brief Returns the height of the preview.
+     *
+     * @return const size_t& - The height in pixel.
+     */
+    const size_t &Preview::getHeight() const{
+        return this->height;
+    }
+
+    /**
+     * @brief Builds the camera of the preview, with its aspect ratio.
+     *
+     * @param settings - The settings of the camera.
+     * @return Camera - The camera.
+     */
+    Camera Preview::getCamera(const Camera::settings &settings) const{
+        return {settings.lookFrom, settings.lookAt, settings.up, settings.vfov, this->width / float(this->height),
+                settings.aperture, settings.focus, settings.t0, settings.t1};
+    }
+
+    /**
+     * @brief Tells if two cameras take the same image.
+     *
+     * @param a - The first camera.
+     * @param b - The second camera.
+     * @return true - If all their settings are the same.
+     * @return false - Otherwise.
+     */
+    bool Preview::isSame(const Camera::settings &a, const Camera::settings &b){
+        return a.lookFrom == b.lookFrom && a.lookAt == b.lookAt && a.up == b.up && a.vfov == b.vfov &&
+               a.aperture == b.aperture && a.focus == b.focus && a.t0 == b.t0 && a.t1 == b.t1;
+    }
+
+    /**
+     * @brief Traces a new sample for every pixel and adds it to the ones of the previous frames:
+     *        all of them if the view has not changed, otherwise the ones reprojected from the previous frame.
+     *
+     * @param settings - The camera of the frame.
+     * @param trace - The renderer, called by many threads.
+     * @param sceneChanged - If the objects of the scene have changed since the previous frame.
+     * @return frame_stats - If the view has changed, the fraction of pixels reprojected and the average samples.
+     */
+    Preview::frame_stats Preview::render(const Camera::settings &settings, const integrator &trace, const bool sceneChanged){
+        utility::Profiler::Zone zone{"preview"};
+        const bool moved = !this->started || sceneChanged || !isSame(settings, this->settings);
+        const Camera camera = this->getCamera(settings), previous = this->getCamera(this->settings);
+        const long height = this->height, width = this->width;
+        const bool reproject = moved && this->started;
+        const Vec3 previousOrigin = this->settings.lookFrom;
+        size_t reused = 0;
+        double samples = 0;
+
+        if(moved)
+            swap(this->pixels, this->history);
+        this->settings = settings;
+        this->started = true;
+
+        #pragma omp parallel for reduction(+:reused, samples)
+        for(long row = 0; row < height; ++row){
+            for(long column = 0; column < width; ++column){
+                const Ray ray = camera.get_ray((column + rand_float()) / width, (height - 1 - row + rand_float()) / height);
+                const sample result = trace(ray);
+                const Vec3 point = result.hit ? result.point : ray.getDirection().normalize();
+                pixel &current = this->pixels[row * width + column];
+
+                if(!moved){
+                    current.samples += 1;
+                    current.mean += (result.color - current.mean) / current.samples;
+                }
+                else{
+                    current = {result.color, point, 1, result.hit};
+
+                    // Look for the point in the previous frame, a direction is seen at any distance.
+                    float s, t;
+                    if(reproject && previous.project(result.hit ? point : previousOrigin + point, s, t) &&
+                       s >= 0 && s < 1 && t >= 0 && t < 1){
+                        const pixel &old = this->history[(height - 1 - static_cast<long>(t * height)) * width + static_cast<long>(s * width)];
+                        const float scale = result.hit ? (point - settings.lookFrom).length() : 1;
+                        if(old.samples > 0 && old.hit == result.hit && (old.point - point).length() <= TOLERANCE * scale){
+                            current.samples = min(old.samples, MAX_REPROJECTED) + 1;
+                            current.mean = old.mean + (result.color - old.mean) / current.samples;
+                            ++reused;
+                        }
+                    }
+                }
+                current.point = point;
+                current.hit = result.hit;
+                samples += current.samples;
+            }
+        }
+
+        const float count = this->width * this->height;
+        return {moved, reused / count, static_cast<float>(samples / count)};
+    }
+
+    /**
+     * @brief Returns the image of the preview, as the renderer writes it: the square root of the average
+     *        of the samples of every pixel, from 0 to 255, row by row from the top.
+     *
+     * @return std::vector<geometry::Vec3> - The colors of the pixels.
+     */
+    std::vector<Vec3> Preview::getImage() const{
+        std::vector<Vec3> image(this->pixels.size());
+        transform(this->pixels.begin(), this->pixels.end(), image.begin(),
+                  [](const pixel &p){ return Vec3{sqrt(p.mean.x()), sqrt(p.mean.y()), sqrt(p.mean.z())} * 255.99; });
+        return image;
+    }
+
+    /**
+     * @brief Discards the samples, so that the next frame starts from scratch.
+     *
+     */
+    void Preview::reset(){
+        this->started = false;
+        fill(this->pixels.begin(), this->pixels.end(), pixel{});
+        fill(this->history.begin(), this->history.end(), pixel{});
+    }
+
+}
@@ -0,0 +1,95 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PREVIEW HEADER FILE                                *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_PREVIEW_S
+#define S_PREVIEW_S
+
+// System includes.
+#include <functional>
+#include <vector>
+
+// My includes.
+#include "Camera.hpp"
+#include "Ray.hpp"
+#include "geometry/Vec3.hpp"
+
+namespace srt{
+
+/// An interactive preview of a scene: every frame traces one sample per pixel, usually at a lower
+/// resolution than the one of the scene, and adds it to the samples of the previous frames.
+/// While the camera and the scene stay still, the samples of a pixel are averaged, so the image
+/// gets cleaner at every frame. When they change, every pixel looks for its first hit in the
+/// previous frame (reprojection): if that frame saw the same point, the pixel keeps up to
+/// MAX_REPROJECTED of its samples, otherwise it starts again from the new one.
+class Preview{
+public:
+    // CONSTANTS
+
+    static constexpr float MAX_REPROJECTED = 16;
+    /// How far the points seen by a pixel in two frames can be, relative to their distance from the camera.
+    static constexpr float TOLERANCE = 0.02;
+
+    // STRUCTURES
+
+    /// What a ray sees: its color and the first point it hits, if one.
+    typedef struct sm{
+        geometry::Vec3 color, point;
+        bool hit;
+    } sample;
+
+    /// The color of a ray, traced by the renderer.
+    typedef std::function<sample(const Ray &ray)> integrator;
+
+    /// How a frame has been made: if the view has changed, the fraction of the pixels that has
+    /// kept the samples of the previous frame, and the average samples per pixel.
+    typedef struct fs{
+        bool moved;
+        float reused, samples;
+    } frame_stats;
+
+private:
+    // STRUCTURES
+
+    /// The average of the samples of a pixel, and the first hit of the last one: the point, or the
+    /// direction of the ray if it has hit nothing.
+    typedef struct px{
+        geometry::Vec3 mean, point;
+        float samples;
+        bool hit;
+    } pixel;
+
+    // ATTRIBUTES
+
+    size_t width, height;
+    std::vector<pixel> pixels, history;
+    Camera::settings settings;
+    bool started;
+
+    // METHODS
+
+    Camera getCamera(const Camera::settings &settings) const;
+    static bool isSame(const Camera::settings &a, const Camera::settings &b);
+
+public:
+    // CONSTRUCTORS
+
+    Preview(const size_t width, const size_t height);
+
+    // METHODS
+
+    const size_t &getWidth() const;
+    const size_t &getHeight() const;
+    frame_stats render(const Camera::settings &settings, const integrator &trace, const bool sceneChanged = false);
+    std::vector<geometry::Vec3> getImage() const;
+    void reset();
+};
+
+}
+
+#endif
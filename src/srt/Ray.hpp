@@ -2,6 +2,7 @@
 #define S_RAY_S
 
 // System includes.
+#include <cstdint>
 #include <memory>
 
 // My includes.
@@ -12,8 +13,19 @@ class Ray{
 private:
     // ATTRIBUTES
 
-    geometry::Vec3 origin, direction;
+    geometry::Vec3 origin, direction, invDirection;
     float time;
+    uint8_t sign[3];
+
+    /**
+     * @brief Computes the sign of the components of the inverse direction, 1 if negative. A zero
+     *        component of the direction gives an infinite inverse, whose sign is the one of the zero.
+     * 
+     */
+    VM_INLINE void computeSign(){
+        for(uint8_t i = 0; i < 3; ++i)
+            this->sign[i] = std::signbit(this->invDirection[i]);
+    }
 
 public:
     /**
@@ -24,14 +36,17 @@ public:
      * @param time - The time the ray is shot.
      */
     Ray(const geometry::Vec3 &origin, const geometry::Vec3 &direction, const float time = 1) : origin(origin), 
-        direction(direction.normalize()), time(time) {}
+        direction(direction.normalize()), invDirection(geometry::Vec3{1} / this->direction), time(time) {
+        this->computeSign();
+    }
 
     /**
      * @brief Creates a new ray equal to an old one.
      * 
      * @param old - The old ray.
      */
-    Ray(const Ray &old) : origin(old.origin), direction(old.direction), time(old.time) {}
+    Ray(const Ray &old) : origin(old.origin), direction(old.direction), invDirection(old.invDirection), time(old.time), 
+        sign{old.sign[0], old.sign[1], old.sign[2]} {}
 
     /**
      * @brief Returns a copy of the vector that indicates the origin of the ray.
@@ -51,6 +66,26 @@ public:
         return this->direction;
     }
 
+    /**
+     * @brief Returns the inverse of the direction, computed once when the ray is created so that 
+     *        the slab tests multiply instead of dividing.
+     * 
+     * @return const geometry::Vec3& - The componentwise inverse of the direction.
+     */
+    VM_INLINE const geometry::Vec3& getInvDirection() const{
+        return this->invDirection;
+    }
+
+    /**
+     * @brief Returns the signs of the inverse direction, used to select the near and the far 
+     *        plane of a slab without comparisons.
+     * 
+     * @return const uint8_t* - The three signs, 1 if the component is negative, 0 otherwise.
+     */
+    VM_INLINE const uint8_t* getSign() const{
+        return this->sign;
+    }
+
     /**
      * @brief Returns the time on which the ray was shot.
      * 
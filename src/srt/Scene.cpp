@@ -12,9 +12,12 @@
 // System includes.
 #include <cmath>
 #include <queue> 
+#include <stdexcept>
 
 // My includes.
 #include "geometry/shapes/Sphere.hpp"
+#include "textures/ImageTexture.hpp"
+#include "utility/Profiler.hpp"
 
 using namespace std;
 using namespace srt::geometry;
@@ -34,9 +37,13 @@ namespace srt{
      * @param name - The name of the scene.
      * @param t0 - The first instant of time considered in the scene. 0 by default.
      * @param t1 - The last instant of time considered in the scene. 1 by default.
+     * @param arena - The arena of the objects, shared with the code that created them. A new one if null.
      */
-    Scene::Scene(const float width, const float height, const string &name, const float t0, const float t1) :
-        height(height), width(width), name(name), t0(t0), t1(t1) { }
+    Scene::Scene(const float width, const float height, const string &name, const float t0, const float t1, 
+                 const shared_ptr<utility::Arena> &arena) :
+        height(height), width(width), t0(t0), t1(t1), builtAreaSum(0), areaSum(0), name(name), 
+        arena(arena != nullptr ? arena : make_shared<utility::Arena>()), treeArena(make_shared<utility::Arena>()), 
+        treeOwners(make_shared<const bool>(true)), indexed(false) { }
 
     /**
      * @brief Returns the height of the scene.
@@ -74,13 +81,98 @@ namespace srt{
         return this->hitablesTree.getDepth(); 
     }
 
+    /**
+     * @brief Returns the table of the materials used by the scene. It is filled by buildBVH.
+     * 
+     * @return const materials::MaterialTable& - The materials.
+     */
+    const materials::MaterialTable &Scene::getMaterials() const{
+        return this->materialTable;
+    }
+
+    /**
+     * @brief Returns how much the BVH has degraded since it was built: the ratio between its cost
+     *        and the cost it had when built, both normalized by the area of the root when built, 
+     *        that is the ratio between the sums of the surface areas of the nodes. See BVH::getCost.
+     *        The area of the root at the time is not used, since an edit that makes the root larger
+     *        would lower the cost of a worse tree.
+     * 
+     * @return float - The ratio, 1 for a tree just built.
+     */
+    float Scene::getHierarchyCostRatio() const{
+        return this->builtAreaSum > 0 ? this->areaSum / this->builtAreaSum : 1;
+    }
+
+    /**
+     * @brief Returns the arena of the objects of the scene.
+     * 
+     * @return const shared_ptr<utility::Arena>& - The arena.
+     */
+    const shared_ptr<utility::Arena> &Scene::getArena() const{
+        return this->arena;
+    }
+
+    /**
+     * @brief Returns the memory taken by the nodes of the BVH.
+     * 
+     * @return utility::Arena::arena_stats - The memory of the arena of the nodes.
+     */
+    utility::Arena::arena_stats Scene::getTreeArenaStats() const{
+        return this->treeArena->getStats();
+    }
+
     /**
      * @brief Builds a new tree for the BVH. This function should be called every time
      *        the user want to update the bvh after inserting new object.
      * 
      */
     void Scene::buildBVH(){
-        this->hitablesTree = {this->hitables, this->t0, this->t1};
+        utility::Profiler::Zone zone{"BVH build"};
+
+        for(const auto &hitable : this->hitables)
+            hitable->bindMaterials(this->materialTable);
+        this->materialTable.releaseDuplicates();
+
+        // Decode the images in background while the tree is built, once the duplicates are gone.
+        textures::ImageTexture::prefetch();
+        // The nodes of the leaves change, they are indexed again by the next edit.
+        this->leaves.clear();
+        this->positions.clear();
+        this->indexed = false;
+        // Free the old nodes and reuse their arena, unless they are still shared by a copy of the scene.
+        this->hitablesTree = {};
+        if(this->treeOwners.use_count() == 1)
+            this->treeArena->reset();
+        else{
+            this->treeArena = make_shared<utility::Arena>();
+            this->treeOwners = make_shared<const bool>(true);
+        }
+        if(!this->hitables.empty())
+            this->hitablesTree = {this->hitables, this->t0, this->t1, this->treeArena.get()};
+        this->builtAreaSum = this->areaSum = this->hitablesTree.isEmpty() ? 0 : this->hitablesTree.getAreaSum();
+    }
+
+    /**
+     * @brief Updates the BVH after the hitables have moved, without adding or removing them.
+     *        The boxes are refitted, and the tree is built again only if the refitted one costs
+     *        more than threshold times the one just built, see getHierarchyCostRatio.
+     * 
+     * @param threshold - The ratio between the cost of the refitted tree and the cost of the built one
+     *                    over which the tree is built again.
+     * @return true - If the tree has been built again.
+     * @return false - If the tree has been refitted.
+     */
+    bool Scene::refitBVH(const float threshold){
+        {
+            utility::Profiler::Zone zone{"BVH refit"};
+            this->ownTree();
+            this->areaSum = this->hitablesTree.refit(this->t0, this->t1);
+            if(this->areaSum <= this->builtAreaSum * threshold)
+                return false;
+        }
+
+        this->buildBVH();
+        return true;
     }
 
     /**
@@ -92,6 +184,112 @@ namespace srt{
         this->hitables.insert(this->hitables.end(), newHitables.begin(), newHitables.end());
     }
 
+    /**
+     * @brief Copies the nodes of the BVH in a new arena if they are shared with a copy of the scene,
+     *        so that they can be refitted and edited without changing the copy. The copy is indexed
+     *        again by the next edit.
+     * 
+     */
+    void Scene::ownTree(){
+        if(this->treeOwners.use_count() == 1)    return;
+
+        utility::Profiler::Zone zone{"BVH copy"};
+        const shared_ptr<utility::Arena> treeArena = make_shared<utility::Arena>();
+        this->hitablesTree = this->hitablesTree.clone(treeArena.get());
+        this->treeArena = treeArena;
+        this->treeOwners = make_shared<const bool>(true);
+        this->leaves.clear();
+        this->positions.clear();
+        this->indexed = false;
+    }
+
+    /**
+     * @brief Records the node of every hitable in the tree and its position in the scene, 
+     *        if it has not been done since the tree was built.
+     * 
+     */
+    void Scene::indexBVH(){
+        if(this->indexed)   return;
+
+        utility::Profiler::Zone zone{"BVH index"};
+        this->hitablesTree.index(this->leaves);
+        for(size_t i = 0; i < this->hitables.size(); ++i)
+            this->positions[this->hitables[i].get()] = i;
+        this->indexed = true;
+    }
+
+    /**
+     * @brief Adds the materials of a hitable to the table of the scene, as buildBVH does.
+     * 
+     * @param hitable - The hitable.
+     */
+    void Scene::bindMaterials(Hitable &hitable){
+        hitable.bindMaterials(this->materialTable);
+        this->materialTable.releaseDuplicates();
+        textures::ImageTexture::prefetch();
+    }
+
+    /**
+     * @brief Inserts a hitable in the scene and in its BVH, without building the tree again.
+     * 
+     * @param hitable - The hitable, that must not be in the scene.
+     */
+    void Scene::insertHitable(const shared_ptr<Hitable> &hitable){
+        utility::Profiler::Zone zone{"BVH insert"};
+        this->ownTree();
+        this->indexBVH();
+        if(hitable == nullptr || this->positions.count(hitable.get()) > 0)
+            throw invalid_argument("The hitable is null or already in the scene");
+
+        this->bindMaterials(*hitable);
+        this->areaSum += this->hitablesTree.insert(hitable, this->t0, this->t1, this->treeArena.get(), this->leaves);
+        this->positions[hitable.get()] = this->hitables.size();
+        this->hitables.push_back(hitable);
+    }
+
+    /**
+     * @brief Removes a hitable from the scene and from its BVH, without building the tree again.
+     * 
+     * @param hitable - The hitable, that must be in the scene.
+     */
+    void Scene::removeHitable(const shared_ptr<Hitable> &hitable){
+        utility::Profiler::Zone zone{"BVH remove"};
+        this->ownTree();
+        this->indexBVH();
+        const auto it = this->positions.find(hitable.get());
+        if(it == this->positions.end())
+            throw invalid_argument("The hitable is not in the scene");
+
+        this->areaSum += this->hitablesTree.remove(hitable.get(), this->t0, this->t1, this->treeArena.get(), this->leaves);
+
+        // The last hitable takes the place of the removed one.
+        const size_t position = it->second;
+        this->positions.erase(it);
+        if(position + 1 < this->hitables.size()){
+            this->hitables[position] = this->hitables.back();
+            this->positions[this->hitables[position].get()] = position;
+        }
+        this->hitables.pop_back();
+    }
+
+    /**
+     * @brief Updates the BVH after a hitable has changed, for example it has been moved or its material 
+     *        has been changed. The hitable is removed from the tree and inserted again where it fits better.
+     * 
+     * @param hitable - The hitable, that must be in the scene.
+     */
+    void Scene::updateHitable(const shared_ptr<Hitable> &hitable){
+        utility::Profiler::Zone zone{"BVH update"};
+        this->ownTree();
+        this->indexBVH();
+        if(this->positions.count(hitable.get()) == 0)
+            throw invalid_argument("The hitable is not in the scene");
+
+        this->bindMaterials(*hitable);
+        this->areaSum += this->hitablesTree.remove(hitable.get(), this->t0, this->t1, this->treeArena.get(), this->leaves);
+        this->areaSum += this->hitablesTree.insert(hitable, this->t0, this->t1, this->treeArena.get(), this->leaves);
+    }
+
     /**
      * @brief Returns the object intersected by the ray, if one. If no object has been intersected,
      *        returns nullptr.
@@ -104,6 +302,6 @@ namespace srt{
      * @return std::shared_ptr<Hitable> - The closer Hitable intersected.
      */
     const Hitable::hit_record Scene::intersection(const Ray &ray, const float tmin, const float tmax) const{
-        return this->hitablesTree.intersection(ray, tmin, tmax);
+        return this->hitablesTree.isEmpty() ? Hitable::NO_HIT : this->hitablesTree.intersection(ray, tmin, tmax);
     }
 }
\ No newline at end of file
@@ -14,29 +14,55 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 // My includes.
 #include "Ray.hpp"
 #include "Hitable.hpp"
 #include "ds/BVH.hpp"
+#include "utility/Arena.hpp"
 
 namespace srt{
 
+/// A scene owns an arena for its objects, created with make(), and one for the nodes of its BVH,
+/// that is reused every time the BVH is built again. The arenas are freed in one operation when
+/// the scene and its objects are destroyed. The primitives should be created in the arena, while
+/// the materials are better left on the heap: the duplicates collapsed by the table are freed.
+/// Once the BVH has been built, the hitables can be inserted, removed and updated one by one in 
+/// a time that depends on the depth of the tree, that is kept logarithmic, not on the number of hitables. The first edit 
+/// after every build indexes the tree. The edits make the tree worse: build it again when 
+/// getHierarchyCostRatio grows too much. A scene must not be edited while it is being rendered.
+/// The copies of a scene share the nodes of the BVH until one of them refits or edits its tree,
+/// which copies the nodes first.
 class Scene{
 private:
     // ATTRIBUTES
 
-    float height, width, t0, t1;
+    float height, width, t0, t1, builtAreaSum, areaSum;
     std::string name;
+    std::shared_ptr<utility::Arena> arena, treeArena;
+    // Shared only by the copies of the scene that share the nodes of the BVH. The use count of the tree
+    // arena cannot tell it, since every node keeps the arena alive.
+    std::shared_ptr<const bool> treeOwners;
     ds::BVH hitablesTree;
     std::vector<std::shared_ptr<Hitable>> hitables = {};
+    materials::MaterialTable materialTable;
+    ds::BVH::leaf_index leaves;
+    std::unordered_map<const Hitable*, size_t> positions;
+    bool indexed;
+
+    // METHODS
+
+    void ownTree();
+    void indexBVH();
+    void bindMaterials(Hitable &hitable);
 
 public:
 
     // CONSTRUCTORS
     
     Scene(const float width, const float height, const std::string &name, 
-            const float t0 = 0, const float t1 = 1);
+            const float t0 = 0, const float t1 = 1, const std::shared_ptr<utility::Arena> &arena = nullptr);
     
     // METHODS
 
@@ -44,9 +70,28 @@ public:
     const float& getWidth() const;
     const std::string& getName() const;
     const size_t &getHierarchyDepth() const;
+    float getHierarchyCostRatio() const;
+    const materials::MaterialTable &getMaterials() const;
+    const std::shared_ptr<utility::Arena> &getArena() const;
+    utility::Arena::arena_stats getTreeArenaStats() const;
     void buildBVH();
+    bool refitBVH(const float threshold);
     void addHitables(const std::vector<std::shared_ptr<Hitable>> &newHitables);
+    void insertHitable(const std::shared_ptr<Hitable> &hitable);
+    void removeHitable(const std::shared_ptr<Hitable> &hitable);
+    void updateHitable(const std::shared_ptr<Hitable> &hitable);
     const Hitable::hit_record intersection(const Ray &ray, const float tmin, const float tmax) const;
+
+    /**
+     * @brief Creates an object in the arena of the scene.
+     * 
+     * @param args - The arguments of the constructor of the object.
+     * @return std::shared_ptr<T> - The object.
+     */
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args){
+        return this->arena->make<T>(std::forward<Args>(args)...);
+    }
 };
 }
 
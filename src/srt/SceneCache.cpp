@@ -0,0 +1,339 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SCENE CACHE CLASS FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "SceneCache.hpp"
+
+// System includes.
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+
+// My includes.
+#include "geometry/shapes/Sphere.hpp"
+#include "materials/Dielectric.hpp"
+#include "materials/Lambertian.hpp"
+#include "materials/Metal.hpp"
+#include "materials/lights/DiffuseLight.hpp"
+#include "textures/ImageTexture.hpp"
+#include "textures/StaticTexture.hpp"
+#include "utility/MappedFile.hpp"
+
+using namespace std;
+using namespace srt::ds;
+using namespace srt::geometry;
+using namespace srt::geometry::shapes;
+using namespace srt::materials;
+using namespace srt::materials::lights;
+using namespace srt::textures;
+
+namespace srt{
+
+    /// The header of a cache. It is followed by the name of the scene, by the materials and by the
+    /// paths of the images (each one preceded by its length as a 32 bit integer). The nodes and the
+    /// spheres start at the offsets written here, multiple of ALIGNMENT. The camera and the background
+    /// are the ones of SceneCache::scene_view.
+    typedef struct ch{
+        char magic[4];
+        uint32_t version;
+        float width, height;
+        uint32_t nameLength, materialCount, pathCount, padding;
+        uint64_t nodeCount, sphereCount, nodesOffset, spheresOffset;
+        float lookFrom[3], lookAt[3], up[3], vfov, aperture, focus, t0, t1, background[3];
+        uint32_t sky, viewPadding;
+    } cache_header;
+
+    /// The kind of texture of a material.
+    enum TextureKind : uint32_t {NO_TEXTURE, COLOR, IMAGE};
+
+    /// A material. The color is the albedo or the attenuation, the parameter is the fuziness of a
+    /// metal or the refractivity of a dielectric and the path is the index of the image of the texture.
+    typedef struct cm{
+        uint32_t kind, texture;
+        float color[3], parameter;
+        uint32_t path;
+    } cache_material;
+
+    static const char CACHE_MAGIC[4] = {'S', 'R', 'T', 'C'};
+
+    /**
+     * @brief Returns a number rounded up to the next multiple of ALIGNMENT.
+     *
+     */
+    static inline size_t align(const size_t n){
+        return (n + SceneCache::ALIGNMENT - 1) / SceneCache::ALIGNMENT * SceneCache::ALIGNMENT;
+    }
+
+    /**
+     * @brief Describes the texture of a material, adding the path of its image to the paths.
+     *
+     * @param texture - The texture.
+     * @param record - The material that uses the texture.
+     * @param paths - The paths of the images already found.
+     */
+    static void describeTexture(const shared_ptr<Texture> &texture, cache_material &record, vector<string> &paths){
+        if(const auto color = dynamic_pointer_cast<StaticTexture>(texture)){
+            record.texture = COLOR;
+            for(int i = 0; i < 3; ++i)  record.color[i] = color->getColor()[i];
+        }
+        else if(const auto image = dynamic_pointer_cast<ImageTexture>(texture)){
+            record.texture = IMAGE;
+            size_t i = 0;
+            while(i < paths.size() && paths[i] != image->getPath())     ++i;
+            if(i == paths.size())   paths.push_back(image->getPath());
+            record.path = i;
+        }
+        else
+            throw invalid_argument("Only the color and image textures can be cached");
+    }
+
+    /**
+     * @brief Creates the texture of a material read from a cache.
+     *
+     * @param record - The material.
+     * @param paths - The paths of the images.
+     * @return std::shared_ptr<textures::Texture> - The texture.
+     */
+    static shared_ptr<Texture> createTexture(const cache_material &record, const vector<string> &paths){
+        if(record.texture == COLOR)
+            return make_shared<StaticTexture>(Vec3{record.color[0], record.color[1], record.color[2]});
+        if(record.texture == IMAGE && record.path < paths.size())
+            return make_shared<ImageTexture>(paths[record.path]);
+        throw invalid_argument("The texture of a cached material is not valid");
+    }
+
+    /**
+     * @brief Builds the flat hierarchy of some hitables, that can be written in a cache.
+     *
+     * @param hitables - The hitables. Only the static spheres are supported.
+     * @return std::shared_ptr<ds::FlatBVH> - The hierarchy.
+     */
+    shared_ptr<FlatBVH> SceneCache::flatten(const vector<shared_ptr<Hitable>> &hitables){
+        vector<FlatBVH::sphere> spheres;
+        vector<shared_ptr<Material>> palette;
+        unordered_map<const Material*, uint32_t> ids;
+
+        spheres.reserve(hitables.size());
+        for(const shared_ptr<Hitable> &hitable : hitables){
+            if(hitable == nullptr || typeid(*hitable) != typeid(Sphere))
+                throw invalid_argument("Only the static spheres can be cached");
+
+            const Sphere &s = static_cast<const Sphere&>(*hitable);
+            const shared_ptr<Material> &material = s.getMaterial();
+            const auto id = ids.emplace(material.get(), palette.size());
+            if(id.second)   palette.push_back(material);
+
+            const Vec3 &center = s.getCenter();
+            spheres.push_back({{center[0], center[1], center[2]}, s.getRay(), id.first->second});
+        }
+
+        return make_shared<FlatBVH>(spheres, palette);
+    }
+
+    /**
+     * @brief Writes a scene in a cache. The cache is written next to the file, with the TEMPORARY suffix,
+     *        and then renamed to it, so a reader sees either the old cache or the whole new one.
+     *
+     * @param path - The file to write. It should have the EXTENSION.
+     * @param name - The name of the scene.
+     * @param width - The width of the scene.
+     * @param height - The height of the scene.
+     * @param view - How the scene is shot.
+     * @param hierarchy - The hierarchy of the spheres of the scene.
+     */
+    void SceneCache::write(const string &path, const string &name, const float width, const float height,
+                           const scene_view &view, const FlatBVH &hierarchy){
+        vector<cache_material> materials;
+        vector<string> paths;
+
+        for(const shared_ptr<Material> &material : hierarchy.getPalette()){
+            cache_material record{};
+            if(const auto lambertian = dynamic_pointer_cast<Lambertian>(material)){
+                record.kind = MaterialTable::LAMBERTIAN;
+                describeTexture(lambertian->getAlbedo(), record, paths);
+            }
+            else if(const auto light = dynamic_pointer_cast<DiffuseLight>(material)){
+                record.kind = MaterialTable::DIFFUSE_LIGHT;
+                describeTexture(light->getAlbedo(), record, paths);
+            }
+            else if(const auto metal = dynamic_pointer_cast<Metal>(material)){
+                record.kind = MaterialTable::METAL;
+                for(int i = 0; i < 3; ++i)  record.color[i] = metal->getAlbedo()[i];
+                record.parameter = metal->getFuziness();
+            }
+            else if(const auto dielectric = dynamic_pointer_cast<Dielectric>(material)){
+                record.kind = MaterialTable::DIELECTRIC;
+                for(int i = 0; i < 3; ++i)  record.color[i] = dielectric->getAttenuation()[i];
+                record.parameter = dielectric->getRefractivity();
+            }
+            else
+                throw invalid_argument("Only the lambertian, metal, dielectric and diffuse light materials can be cached");
+            materials.push_back(record);
+        }
+
+        // Serialize everything before the nodes.
+        vector<unsigned char> bytes(sizeof(cache_header));
+        const auto append = [&bytes](const void *data, const size_t size){
+            const unsigned char *begin = static_cast<const unsigned char*>(data);
+            bytes.insert(bytes.end(), begin, begin + size);
+        };
+        append(name.data(), name.size());
+        append(materials.data(), materials.size() * sizeof(cache_material));
+        for(const string &p : paths){
+            const uint32_t length = p.size();
+            append(&length, sizeof(length));
+            append(p.data(), p.size());
+        }
+
+        cache_header header{};
+        memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.width = width;
+        header.height = height;
+        header.nameLength = name.size();
+        header.materialCount = materials.size();
+        header.pathCount = paths.size();
+        header.nodeCount = hierarchy.getNodeCount();
+        header.sphereCount = hierarchy.getSphereCount();
+        header.nodesOffset = align(bytes.size());
+        header.spheresOffset = align(header.nodesOffset + header.nodeCount * sizeof(FlatBVH::node));
+        for(int i = 0; i < 3; ++i){
+            header.lookFrom[i] = view.camera.lookFrom[i];
+            header.lookAt[i] = view.camera.lookAt[i];
+            header.up[i] = view.camera.up[i];
+            header.background[i] = view.background[i];
+        }
+        header.vfov = view.camera.vfov;
+        header.aperture = view.camera.aperture;
+        header.focus = view.camera.focus;
+        header.t0 = view.camera.t0;
+        header.t1 = view.camera.t1;
+        header.sky = view.sky;
+        memcpy(bytes.data(), &header, sizeof(header));
+        bytes.resize(header.nodesOffset, 0);
+
+        const string temporary = path + TEMPORARY;
+        FILE *file = fopen(temporary.c_str(), "wb");
+        if(file == nullptr)
+            throw invalid_argument("The file " + path + " cannot be written");
+
+        const size_t nodesBytes = header.nodeCount * sizeof(FlatBVH::node);
+        const vector<unsigned char> padding(header.spheresOffset - header.nodesOffset - nodesBytes, 0);
+        bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        written = written && fwrite(hierarchy.getNodes(), 1, nodesBytes, file) == nodesBytes;
+        written = written && fwrite(padding.data(), 1, padding.size(), file) == padding.size();
+        written = written && fwrite(hierarchy.getSpheres(), sizeof(FlatBVH::sphere), header.sphereCount, file) == header.sphereCount;
+
+        error_code error;
+        if(fclose(file) != 0 || !written){
+            filesystem::remove(temporary, error);
+            throw runtime_error("Cannot write the file " + path);
+        }
+        filesystem::rename(temporary, path, error);
+        if(error){
+            filesystem::remove(temporary, error);
+            throw runtime_error("Cannot write the file " + path);
+        }
+    }
+
+    /**
+     * @brief Loads a scene from a cache. The hierarchy is used in place from the mapped file.
+     *
+     * @param path - The file written by write().
+     * @param view - Set to how the scene is shot.
+     * @return Scene - The scene, with its hierarchy already built.
+     */
+    Scene SceneCache::load(const string &path, scene_view &view){
+        const auto file = make_shared<utility::MappedFile>(path);
+        const unsigned char *data = file->getData();
+        const size_t size = file->getSize();
+        cache_header header;
+
+        if(size < sizeof(header))
+            throw invalid_argument("The file " + path + " is not a scene cache");
+        memcpy(&header, data, sizeof(header));
+        if(memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != VERSION)
+            throw invalid_argument("The file " + path + " is not a scene cache");
+
+        const uint64_t materialsOffset = sizeof(header) + uint64_t(header.nameLength);
+        const uint64_t pathsOffset = materialsOffset + uint64_t(header.materialCount) * sizeof(cache_material);
+        if(header.nodesOffset % ALIGNMENT != 0 || header.spheresOffset % ALIGNMENT != 0 || pathsOffset > header.nodesOffset ||
+           header.nodesOffset > size || header.nodeCount > (size - header.nodesOffset) / sizeof(FlatBVH::node) ||
+           header.spheresOffset < header.nodesOffset + header.nodeCount * sizeof(FlatBVH::node) || header.spheresOffset > size ||
+           header.sphereCount > (size - header.spheresOffset) / sizeof(FlatBVH::sphere))
+            throw invalid_argument("The file " + path + " is truncated");
+
+        const string name{reinterpret_cast<const char*>(data + sizeof(header)), header.nameLength};
+        vector<string> paths;
+        uint64_t offset = pathsOffset;
+        for(uint32_t i = 0; i < header.pathCount; ++i){
+            uint32_t length;
+            if(offset + sizeof(length) > header.nodesOffset)
+                throw invalid_argument("The file " + path + " is truncated");
+            memcpy(&length, data + offset, sizeof(length));
+            offset += sizeof(length);
+            if(offset + length > header.nodesOffset)
+                throw invalid_argument("The file " + path + " is truncated");
+            paths.emplace_back(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+        }
+
+        vector<shared_ptr<Material>> palette;
+        for(uint32_t i = 0; i < header.materialCount; ++i){
+            cache_material record;
+            memcpy(&record, data + materialsOffset + i * sizeof(cache_material), sizeof(record));
+            const Vec3 color{record.color[0], record.color[1], record.color[2]};
+            switch(record.kind){
+                case MaterialTable::LAMBERTIAN:
+                    palette.push_back(make_shared<Lambertian>(createTexture(record, paths)));
+                    break;
+                case MaterialTable::DIFFUSE_LIGHT:
+                    palette.push_back(make_shared<DiffuseLight>(createTexture(record, paths)));
+                    break;
+                case MaterialTable::METAL:
+                    palette.push_back(make_shared<Metal>(color, record.parameter));
+                    break;
+                case MaterialTable::DIELECTRIC:
+                    palette.push_back(make_shared<Dielectric>(record.parameter, color));
+                    break;
+                default:
+                    throw invalid_argument("The file " + path + " contains an unknown material");
+            }
+        }
+
+        const auto nodes = reinterpret_cast<const FlatBVH::node*>(data + header.nodesOffset);
+        const auto spheres = reinterpret_cast<const FlatBVH::sphere*>(data + header.spheresOffset);
+        view = {{{header.lookFrom[0], header.lookFrom[1], header.lookFrom[2]}, {header.lookAt[0], header.lookAt[1], header.lookAt[2]},
+                 {header.up[0], header.up[1], header.up[2]}, header.vfov, header.aperture, header.focus, header.t0, header.t1},
+                header.sky != 0, {header.background[0], header.background[1], header.background[2]}};
+        Scene scene{header.width, header.height, name, header.t0, header.t1};
+        scene.addHitables({scene.make<FlatBVH>(nodes, header.nodeCount, spheres, header.sphereCount, palette, file)});
+        scene.buildBVH();
+
+        return scene;
+    }
+
+    /**
+     * @brief Returns whether a cache exists and it is not older than the file it was made from.
+     *
+     * @param path - The cache.
+     * @param sourcePath - The file converted in the cache.
+     * @return bool - True if the cache can be loaded instead of the source.
+     */
+    bool SceneCache::isFresh(const string &path, const string &sourcePath){
+        error_code error;
+        const auto cacheTime = filesystem::last_write_time(path, error);
+        if(error)   return false;
+        const auto sourceTime = filesystem::last_write_time(sourcePath, error);
+        return !error && cacheTime >= sourceTime;
+    }
+
+}
@@ -0,0 +1,61 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SCENE CACHE HEADER FILE                            *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_SCENECACHE_S
+#define S_SCENECACHE_S
+
+// System includes.
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// My includes.
+#include "Camera.hpp"
+#include "Scene.hpp"
+#include "geometry/Vec3.hpp"
+#include "ds/FlatBVH.hpp"
+
+namespace srt{
+
+/// A binary file with a whole scene: its size, how it is shot, the materials, the paths of the images
+/// used as textures and the hierarchy of the spheres, already built. The hierarchy is mapped in memory and
+/// used in place, so a cached scene is loaded without parsing nor building anything.
+/// The numbers are stored with the byte order of the machine.
+class SceneCache{
+public:
+    // CONSTANTS
+
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr const char *EXTENSION = ".srts";
+    /// Appended to the path of a cache while it is written.
+    static constexpr const char *TEMPORARY = ".tmp";
+
+    // STRUCTURES
+
+    /// How a cached scene is shot: the camera and, if sky is false, the color of the rays that leave it.
+    typedef struct sv{
+        Camera::settings camera;
+        bool sky;
+        geometry::Vec3 background;
+    } scene_view;
+
+    // METHODS
+
+    static std::shared_ptr<ds::FlatBVH> flatten(const std::vector<std::shared_ptr<Hitable>> &hitables);
+    static void write(const std::string &path, const std::string &name, const float width, const float height,
+                      const scene_view &view, const ds::FlatBVH &hierarchy);
+    static Scene load(const std::string &path, scene_view &view);
+    static bool isFresh(const std::string &path, const std::string &sourcePath);
+};
+
+}
+
+#endif
@@ -0,0 +1,682 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SCENE PARSER CLASS FILE                            *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "SceneParser.hpp"
+
+// System includes.
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+// My includes.
+#include "geometry/instances/MovingTranslation.hpp"
+#include "geometry/instances/Rotation.hpp"
+#include "geometry/instances/Translation.hpp"
+#include "geometry/shapes/AABox.hpp"
+#include "geometry/shapes/AARectangle.hpp"
+#include "geometry/shapes/MovingSphere.hpp"
+#include "geometry/shapes/Sphere.hpp"
+#include "materials/Dielectric.hpp"
+#include "materials/Lambertian.hpp"
+#include "materials/Metal.hpp"
+#include "materials/lights/DiffuseLight.hpp"
+#include "textures/CheckerTexture.hpp"
+#include "textures/ImageTexture.hpp"
+#include "textures/NoiseTexture.hpp"
+#include "textures/StaticTexture.hpp"
+#include "utility/ThreadPool.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+using namespace srt::geometry::instances;
+using namespace srt::geometry::shapes;
+using namespace srt::materials;
+using namespace srt::materials::lights;
+using namespace srt::textures;
+using namespace srt::utility;
+
+namespace srt{
+
+    /**
+     * @brief Checks that a member needed to build an object has been read.
+     *
+     * @param value - The member.
+     * @param member - The name of the member.
+     * @param type - The type of the object.
+     * @return const T& - The member.
+     */
+    template<typename T> static const T &required(const T &value, const char *member, const char *type){
+        if(value == nullptr)
+            throw invalid_argument("The " + string{member} + " of a " + type + " is missing");
+        return value;
+    }
+
+    /**
+     * @brief Returns the factories of the shapes and of the instances, starting from the built-in ones.
+     *
+     * @return std::unordered_map<std::string, shape_factory>& - The factories, by type.
+     */
+    unordered_map<string, SceneParser::shape_factory> &SceneParser::shapeFactories(){
+        static unordered_map<string, shape_factory> factories{
+            {"sphere", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                Vec3 center;
+                float ray = 1;
+                shared_ptr<Material> material;
+                readMembers(reader, [&](const string &key){
+                    if(key == "center")                         center = reader.readVec3();
+                    else if(key == "ray" || key == "radius")    ray = reader.readNumber();
+                    else if(key == "material")                  material = parser.readMaterial(reader);
+                    else return false;
+                    return true;
+                });
+                return parser.make<Sphere>(center, ray, required(material, "material", "sphere"));
+            }},
+            {"moving_sphere", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                Vec3 center0, center1;
+                float t0 = 0, t1 = 1, ray = 1;
+                shared_ptr<Material> material;
+                readMembers(reader, [&](const string &key){
+                    if(key == "center0")                        center0 = reader.readVec3();
+                    else if(key == "center1")                   center1 = reader.readVec3();
+                    else if(key == "t0")                        t0 = reader.readNumber();
+                    else if(key == "t1")                        t1 = reader.readNumber();
+                    else if(key == "ray" || key == "radius")    ray = reader.readNumber();
+                    else if(key == "material")                  material = parser.readMaterial(reader);
+                    else return false;
+                    return true;
+                });
+                return parser.make<MovingSphere>(center0, center1, t0, t1, ray, required(material, "material", "moving_sphere"));
+            }},
+            {"rectangle", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                string plane = "xy";
+                float a0[2] = {0, 1}, a1[2] = {0, 1}, k = 0;
+                bool flip = false;
+                shared_ptr<Material> material;
+                readMembers(reader, [&](const string &key){
+                    if(key == "plane")          plane = reader.readString();
+                    else if(key == "a0")        reader.readNumbers(a0, 2);
+                    else if(key == "a1")        reader.readNumbers(a1, 2);
+                    else if(key == "k")         k = reader.readNumber();
+                    else if(key == "flip")      flip = reader.readBoolean();
+                    else if(key == "material")  material = parser.readMaterial(reader);
+                    else return false;
+                    return true;
+                });
+
+                const AARectangle::Type type = plane == "xy" ? AARectangle::XY : plane == "xz" ? AARectangle::XZ : AARectangle::YZ;
+                if(plane != "xy" && plane != "xz" && plane != "yz")
+                    throw invalid_argument("The plane " + plane + " of a rectangle is not xy, xz or yz");
+                return parser.make<AARectangle>(type, a0[0], a0[1], a1[0], a1[1], k, required(material, "material", "rectangle"), flip);
+            }},
+            {"box", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                Vec3 min, max{1, 1, 1};
+                shared_ptr<Material> material;
+                readMembers(reader, [&](const string &key){
+                    if(key == "min")            min = reader.readVec3();
+                    else if(key == "max")       max = reader.readVec3();
+                    else if(key == "material")  material = parser.readMaterial(reader);
+                    else return false;
+                    return true;
+                });
+                return parser.make<AABox>(min, max, required(material, "material", "box"));
+            }},
+            {"translation", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                Vec3 offset;
+                shared_ptr<Hitable> object;
+                vector<Animation::offset_key> keyframes;
+                readMembers(reader, [&](const string &key){
+                    if(key == "offset")             offset = reader.readVec3();
+                    else if(key == "object")        object = parser.readShape(reader);
+                    else if(key == "keyframes")     keyframes = readKeyframes(reader);
+                    else return false;
+                    return true;
+                });
+
+                const auto translation = parser.make<Translation>(required(object, "object", "translation"), offset);
+                parser.animate(translation, keyframes);
+                return translation;
+            }},
+            {"moving_translation", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                Vec3 offset0, offset1;
+                float t0 = 0, t1 = 1;
+                shared_ptr<Hitable> object;
+                vector<Animation::offset_key> keyframes;
+                readMembers(reader, [&](const string &key){
+                    if(key == "offset0")            offset0 = reader.readVec3();
+                    else if(key == "offset1")       offset1 = reader.readVec3();
+                    else if(key == "t0")            t0 = reader.readNumber();
+                    else if(key == "t1")            t1 = reader.readNumber();
+                    else if(key == "object")        object = parser.readShape(reader);
+                    else if(key == "keyframes")     keyframes = readKeyframes(reader);
+                    else return false;
+                    return true;
+                });
+
+                const auto translation = parser.make<MovingTranslation>(required(object, "object", "moving_translation"), 
+                                                                        offset0, offset1, t0, t1);
+                parser.animate(translation, keyframes);
+                return translation;
+            }},
+            {"rotation", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Hitable>{
+                string axis = "pitch";
+                float degree = 0;
+                shared_ptr<Hitable> object;
+                readMembers(reader, [&](const string &key){
+                    if(key == "axis")           axis = reader.readString();
+                    else if(key == "degree")    degree = reader.readNumber();
+                    else if(key == "object")    object = parser.readShape(reader);
+                    else return false;
+                    return true;
+                });
+
+                const Rotation::Type type = axis == "roll" ? Rotation::roll : axis == "pitch" ? Rotation::pitch : Rotation::yaw;
+                if(axis != "roll" && axis != "pitch" && axis != "yaw")
+                    throw invalid_argument("The axis " + axis + " of a rotation is not roll, pitch or yaw");
+                return parser.make<Rotation>(type, required(object, "object", "rotation"), degree);
+            }}
+        };
+        return factories;
+    }
+
+    /**
+     * @brief Returns the factories of the materials, starting from the built-in ones.
+     *
+     * @return std::unordered_map<std::string, material_factory>& - The factories, by type.
+     */
+    unordered_map<string, SceneParser::material_factory> &SceneParser::materialFactories(){
+        static unordered_map<string, material_factory> factories{
+            {"lambertian", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Material>{
+                shared_ptr<Texture> albedo;
+                readMembers(reader, [&](const string &key){
+                    if(key != "albedo")     return false;
+                    albedo = parser.readTexture(reader);
+                    return true;
+                });
+                return make_shared<Lambertian>(required(albedo, "albedo", "lambertian"));
+            }},
+            {"metal", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Material>{
+                Vec3 albedo{1, 1, 1};
+                float fuziness = 0;
+                readMembers(reader, [&](const string &key){
+                    if(key == "albedo")         albedo = reader.readVec3();
+                    else if(key == "fuziness")  fuziness = reader.readNumber();
+                    else return false;
+                    return true;
+                });
+                return make_shared<Metal>(albedo, fuziness);
+            }},
+            {"dielectric", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Material>{
+                float refractivity = 1;
+                Vec3 attenuation{1, 1, 1};
+                readMembers(reader, [&](const string &key){
+                    if(key == "refractivity")       refractivity = reader.readNumber();
+                    else if(key == "attenuation")   attenuation = reader.readVec3();
+                    else return false;
+                    return true;
+                });
+                return make_shared<Dielectric>(refractivity, attenuation);
+            }},
+            {"diffuse_light", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Material>{
+                shared_ptr<Texture> albedo;
+                readMembers(reader, [&](const string &key){
+                    if(key != "albedo")     return false;
+                    albedo = parser.readTexture(reader);
+                    return true;
+                });
+                return make_shared<DiffuseLight>(required(albedo, "albedo", "diffuse_light"));
+            }}
+        };
+        return factories;
+    }
+
+    /**
+     * @brief Returns the factories of the textures, starting from the built-in ones.
+     *
+     * @return std::unordered_map<std::string, texture_factory>& - The factories, by type.
+     */
+    unordered_map<string, SceneParser::texture_factory> &SceneParser::textureFactories(){
+        static unordered_map<string, texture_factory> factories{
+            {"color", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Texture>{
+                Vec3 color;
+                readMembers(reader, [&](const string &key){
+                    if(key != "color")      return false;
+                    color = reader.readVec3();
+                    return true;
+                });
+                return make_shared<StaticTexture>(color);
+            }},
+            {"checker", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Texture>{
+                shared_ptr<Texture> odd, even;
+                readMembers(reader, [&](const string &key){
+                    if(key == "odd")        odd = parser.readTexture(reader);
+                    else if(key == "even")  even = parser.readTexture(reader);
+                    else return false;
+                    return true;
+                });
+                if(odd == nullptr && even == nullptr)   return make_shared<CheckerTexture>();
+                return make_shared<CheckerTexture>(required(odd, "odd", "checker"), required(even, "even", "checker"));
+            }},
+            {"image", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Texture>{
+                string path;
+                readMembers(reader, [&](const string &key){
+                    if(key != "path")       return false;
+                    path = reader.readString();
+                    return true;
+                });
+                if(path.empty())
+                    throw invalid_argument("The path of an image is missing");
+                return make_shared<ImageTexture>(parser.resolvePath(path));
+            }},
+            {"noise", [](SceneParser &parser, JsonReader &reader) -> shared_ptr<Texture>{
+                string pattern = "noise";
+                float scale = 1, octaves = Perlin::DEFAULT_OCTAVES;
+                Vec3 c0{0, 0, 0}, c1{1, 1, 1};
+                readMembers(reader, [&](const string &key){
+                    if(key == "pattern")        pattern = reader.readString();
+                    else if(key == "scale")     scale = reader.readNumber();
+                    else if(key == "octaves")   octaves = reader.readNumber();
+                    else if(key == "c0")        c0 = reader.readVec3();
+                    else if(key == "c1")        c1 = reader.readVec3();
+                    else return false;
+                    return true;
+                });
+
+                static const vector<string> patterns{"noise", "fbm", "turbulence", "marble", "wood"};
+                const size_t index = find(patterns.begin(), patterns.end(), pattern) - patterns.begin();
+                if(index == patterns.size())
+                    throw invalid_argument("The pattern " + pattern + " of a noise texture cannot be found");
+                return make_shared<NoiseTexture>(NoiseTexture::Pattern(index), scale, size_t(max(octaves, 1.f)), c0, c1);
+            }}
+        };
+        return factories;
+    }
+
+    /**
+     * @brief Maps a scene file in memory.
+     *
+     * @param path - The path of the file.
+     */
+    SceneParser::SceneParser(const string &path) : file(path), text(reinterpret_cast<const char*>(file.getData())),
+        path(path), directory(path.substr(0, path.find_last_of('/') + 1)), arena(make_shared<utility::Arena>()) { }
+
+    /**
+     * @brief Reads the members of an object, calling a function with every key. The function reads
+     *        the value of the members it knows, while the others are skipped.
+     *
+     * @param reader - The reader, placed before the object.
+     * @param read - The function, that returns false if it has not read the value.
+     */
+    void SceneParser::readMembers(JsonReader &reader, const function<bool(const string &key)> &read){
+        string key;
+        reader.beginObject();
+        while(reader.nextKey(key))
+            if(!read(key))  reader.skip();
+    }
+
+    /**
+     * @brief Skips an object, that must be the next value.
+     *
+     * @param reader - The reader, placed before the object.
+     * @param start - The offset of the object.
+     * @return size_t - The offset after the object.
+     */
+    size_t SceneParser::skipObject(JsonReader &reader, size_t &start) const{
+        if(reader.peek() != JsonReader::OBJECT)
+            throw invalid_argument("Expected an object at offset " + to_string(reader.getOffset()) + " of " + this->path);
+        start = reader.getOffset();
+        reader.skip();
+        return reader.getOffset();
+    }
+
+    /**
+     * @brief Returns the type of an object, that can be anywhere in the object.
+     *
+     * @param start - The offset of the object.
+     * @param end - The offset after the object.
+     * @return std::string - The value of its "type" member.
+     */
+    string SceneParser::readType(const size_t start, const size_t end) const{
+        JsonReader reader{this->text, end, start};
+        string key;
+
+        reader.beginObject();
+        while(reader.nextKey(key)){
+            if(key == "type")   return reader.readString();
+            reader.skip();
+        }
+        throw invalid_argument("The object at offset " + to_string(start) + " of " + this->path + " has no type");
+    }
+
+    /**
+     * @brief Builds the shape of an object with the factory of its type.
+     *
+     * @param start - The offset of the object.
+     * @param end - The offset after the object.
+     * @return std::shared_ptr<Hitable> - The shape.
+     */
+    shared_ptr<Hitable> SceneParser::buildShape(const size_t start, const size_t end){
+        const string type = this->readType(start, end);
+        const auto factory = shapeFactories().find(type);
+        if(factory == shapeFactories().end())
+            throw invalid_argument("The type of the shape " + type + " cannot be found");
+
+        JsonReader reader{this->text, end, start};
+        return factory->second(*this, reader);
+    }
+
+    /**
+     * @brief Reads a shape or an instance.
+     *
+     * @param reader - The reader, placed before the object.
+     * @return std::shared_ptr<Hitable> - The shape.
+     */
+    shared_ptr<Hitable> SceneParser::readShape(JsonReader &reader){
+        size_t start;
+        const size_t end = this->skipObject(reader, start);
+        return this->buildShape(start, end);
+    }
+
+    /**
+     * @brief Reads a material, that is an object or the name of a material of the file.
+     *
+     * @param reader - The reader, placed before the material.
+     * @return std::shared_ptr<materials::Material> - The material.
+     */
+    shared_ptr<Material> SceneParser::readMaterial(JsonReader &reader){
+        if(reader.peek() == JsonReader::STRING){
+            const string name = reader.readString();
+            const auto material = this->namedMaterials.find(name);
+            if(material == this->namedMaterials.end())
+                throw invalid_argument("The material " + name + " is not defined");
+            return material->second;
+        }
+
+        size_t start;
+        const size_t end = this->skipObject(reader, start);
+        const string type = this->readType(start, end);
+        const auto factory = materialFactories().find(type);
+        if(factory == materialFactories().end())
+            throw invalid_argument("The type of the material " + type + " cannot be found");
+
+        JsonReader object{this->text, end, start};
+        return factory->second(*this, object);
+    }
+
+    /**
+     * @brief Reads a texture, that is an object, the name of a texture of the file or a color.
+     *
+     * @param reader - The reader, placed before the texture.
+     * @return std::shared_ptr<textures::Texture> - The texture.
+     */
+    shared_ptr<Texture> SceneParser::readTexture(JsonReader &reader){
+        const JsonReader::Token token = reader.peek();
+        if(token == JsonReader::ARRAY)
+            return make_shared<StaticTexture>(reader.readVec3());
+        if(token == JsonReader::STRING){
+            const string name = reader.readString();
+            const auto texture = this->namedTextures.find(name);
+            if(texture == this->namedTextures.end())
+                throw invalid_argument("The texture " + name + " is not defined");
+            return texture->second;
+        }
+
+        size_t start;
+        const size_t end = this->skipObject(reader, start);
+        const string type = this->readType(start, end);
+        const auto factory = textureFactories().find(type);
+        if(factory == textureFactories().end())
+            throw invalid_argument("The type of the texture " + type + " cannot be found");
+
+        JsonReader object{this->text, end, start};
+        return factory->second(*this, object);
+    }
+
+    /**
+     * @brief Reads the camera, or a keyframe of the camera.
+     *
+     * @param reader - The reader, placed before the camera.
+     * @param camera - The values of the members missing in the file.
+     * @param frame - Where the frame of a keyframe is read, or null for the camera of the scene.
+     * @return camera_settings - The camera.
+     */
+    SceneParser::camera_settings SceneParser::readCamera(JsonReader &reader, camera_settings camera, float *frame){
+        readMembers(reader, [&](const string &key){
+            if(key == "frame" && frame != nullptr)  *frame = reader.readNumber();
+            else if(key == "lookFrom")  camera.lookFrom = reader.readVec3();
+            else if(key == "lookAt")    camera.lookAt = reader.readVec3();
+            else if(key == "up")        camera.up = reader.readVec3();
+            else if(key == "vfov")      camera.vfov = reader.readNumber();
+            else if(key == "aperture")  camera.aperture = reader.readNumber();
+            else if(key == "focus")     camera.focus = reader.readNumber();
+            else if(key == "t0")        camera.t0 = reader.readNumber();
+            else if(key == "t1")        camera.t1 = reader.readNumber();
+            else return false;
+            return true;
+        });
+        return camera;
+    }
+
+    /**
+     * @brief Reads the frames to render and the keyframes of the camera.
+     *
+     * @param reader - The reader, placed before the animation.
+     * @param still - The camera of the scene, that gives the members missing in the keyframes.
+     */
+    void SceneParser::readAnimation(JsonReader &reader, const camera_settings &still){
+        float first = 0, last = 0, shutter = 0, threshold = Animation::REBUILD_THRESHOLD;
+        vector<Animation::camera_key> cameraKeys;
+        readMembers(reader, [&](const string &key){
+            if(key == "first")              first = reader.readNumber();
+            else if(key == "last")          last = reader.readNumber();
+            else if(key == "shutter")       shutter = reader.readNumber();
+            else if(key == "threshold")     threshold = reader.readNumber();
+            else if(key == "camera"){
+                reader.beginArray();
+                while(reader.nextElement()){
+                    float frame = 0;
+                    const camera_settings camera = this->readCamera(reader, still, &frame);
+                    cameraKeys.push_back({frame, camera});
+                }
+            }
+            else return false;
+            return true;
+        });
+
+        this->animation = Animation{first, last, shutter, threshold};
+        for(const Animation::camera_key &key : cameraKeys)
+            this->animation.addCameraKey(key.frame, key.camera);
+    }
+
+    /**
+     * @brief Reads the keyframes of a translation: an array of objects with a "frame" and an "offset".
+     *
+     * @param reader - The reader, placed before the array.
+     * @return std::vector<Animation::offset_key> - The keyframes.
+     */
+    vector<Animation::offset_key> SceneParser::readKeyframes(JsonReader &reader){
+        vector<Animation::offset_key> keys;
+        reader.beginArray();
+        while(reader.nextElement()){
+            Animation::offset_key key{0, {0, 0, 0}};
+            readMembers(reader, [&](const string &member){
+                if(member == "frame")           key.frame = reader.readNumber();
+                else if(member == "offset")     key.offset = reader.readVec3();
+                else return false;
+                return true;
+            });
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Reads an array of shapes. The array is skipped once to find where the shapes are, then
+     *        the shapes are built by more threads, each one with its own reader, if they are many.
+     *
+     * @param reader - The reader, placed before the array.
+     * @return std::vector<std::shared_ptr<Hitable>> - The shapes, in the order of the file.
+     */
+    vector<shared_ptr<Hitable>> SceneParser::readShapes(JsonReader &reader){
+        vector<pair<size_t, size_t>> spans;
+        reader.beginArray();
+        while(reader.nextElement()){
+            size_t start;
+            const size_t end = this->skipObject(reader, start);
+            spans.push_back({start, end});
+        }
+
+        vector<shared_ptr<Hitable>> shapes(spans.size());
+        if(spans.size() < PARALLEL_SHAPES){
+            for(size_t i = 0; i < spans.size(); ++i)
+                shapes[i] = this->buildShape(spans[i].first, spans[i].second);
+            return shapes;
+        }
+
+        // The named materials and textures are only read now, so the threads share them safely.
+        ThreadPool pool;
+        const size_t chunks = max<size_t>(pool.getSize(), 1), chunkSize = (spans.size() + chunks - 1) / chunks;
+        vector<exception_ptr> errors(chunks);
+        for(size_t c = 0; c < chunks; ++c)
+            pool.submit([this, c, chunkSize, &spans, &shapes, &errors](){
+                try{
+                    for(size_t i = c * chunkSize; i < min((c + 1) * chunkSize, spans.size()); ++i)
+                        shapes[i] = this->buildShape(spans[i].first, spans[i].second);
+                }
+                catch(...){
+                    errors[c] = current_exception();
+                }
+            });
+        pool.wait();
+
+        for(const exception_ptr &error : errors)
+            if(error != nullptr)    rethrow_exception(error);
+        return shapes;
+    }
+
+    /**
+     * @brief Reads the whole file. The members of the scene can be in any order: the textures and
+     *        the materials are read first, so that the shapes can use their names.
+     *
+     * @return scene_file - The content of the file.
+     */
+    SceneParser::scene_file SceneParser::parse(){
+        const string filename = this->path.substr(this->directory.size());
+        scene_file scene{filename.substr(0, filename.find_last_of('.')), 0, 0,
+                         {{0, 0, 0}, {0, 0, -1}, {0, 1, 0}, 40, 0, 10, 0, 1}, true, {0, 0, 0}, {}, this->arena, {}};
+        unordered_map<string, size_t> members;
+        JsonReader reader{this->text, this->file.getSize()};
+        string key;
+
+        reader.beginObject();
+        while(reader.nextKey(key)){
+            reader.peek();
+            members[key] = reader.getOffset();
+            reader.skip();
+        }
+        const auto memberReader = [this, &members](const string &member){
+            return JsonReader{this->text, this->file.getSize(), members.at(member)};
+        };
+
+        // The named textures and materials, in the order of the file.
+        for(const auto &named : {make_pair("textures", false), make_pair("materials", true)}){
+            if(members.count(named.first) == 0)     continue;
+            JsonReader definitions = memberReader(named.first);
+            string name;
+            definitions.beginObject();
+            while(definitions.nextKey(name))
+                if(named.second)    this->namedMaterials[name] = this->readMaterial(definitions);
+                else                this->namedTextures[name] = this->readTexture(definitions);
+        }
+
+        if(members.count("name"))       scene.name = memberReader("name").readString();
+        if(members.count("width"))      scene.width = memberReader("width").readNumber();
+        if(members.count("height"))     scene.height = memberReader("height").readNumber();
+        if(members.count("camera")){
+            JsonReader camera = memberReader("camera");
+            scene.camera = this->readCamera(camera, scene.camera);
+        }
+        if(members.count("background")){
+            JsonReader background = memberReader("background");
+            if(background.peek() != JsonReader::STRING){
+                scene.sky = false;
+                scene.background = background.readVec3();
+            }
+            else if(background.readString() != "sky")
+                throw invalid_argument("The background of " + this->path + " is not \"sky\" nor a color");
+        }
+        if(members.count("animation")){
+            JsonReader animation = memberReader("animation");
+            this->readAnimation(animation, scene.camera);
+        }
+        if(members.count("shapes")){
+            JsonReader shapes = memberReader("shapes");
+            scene.hitables = this->readShapes(shapes);
+        }
+
+        scene.animation = this->animation;
+        return scene;
+    }
+
+    /**
+     * @brief Returns the path of a file named in the scene, that is relative to the scene file.
+     *
+     * @param relativePath - The path written in the scene.
+     * @return std::string - The path to open.
+     */
+    string SceneParser::resolvePath(const string &relativePath) const{
+        const bool absolute = !relativePath.empty() && (relativePath[0] == '/' || relativePath[0] == '\\' ||
+                                                        (relativePath.size() > 1 && relativePath[1] == ':'));
+        return absolute ? relativePath : this->directory + relativePath;
+    }
+
+    /**
+     * @brief Reads a scene file.
+     *
+     * @param path - The path of the file.
+     * @return scene_file - The content of the file.
+     */
+    SceneParser::scene_file SceneParser::load(const string &path){
+        SceneParser parser{path};
+        return parser.parse();
+    }
+
+    /**
+     * @brief Adds the factory of a type of shape or instance, or replaces the one of that type.
+     *        The factories must be registered before parsing.
+     *
+     * @param type - The type.
+     * @param factory - The factory.
+     */
+    void SceneParser::registerShape(const string &type, const shape_factory &factory){
+        shapeFactories()[type] = factory;
+    }
+
+    /**
+     * @brief Adds the factory of a type of material, or replaces the one of that type.
+     *        The factories must be registered before parsing.
+     *
+     * @param type - The type.
+     * @param factory - The factory.
+     */
+    void SceneParser::registerMaterial(const string &type, const material_factory &factory){
+        materialFactories()[type] = factory;
+    }
+
+    /**
+     * @brief Adds the factory of a type of texture, or replaces the one of that type.
+     *        The factories must be registered before parsing.
+     *
+     * @param type - The type.
+     * @param factory - The factory.
+     */
+    void SceneParser::registerTexture(const string &type, const texture_factory &factory){
+        textureFactories()[type] = factory;
+    }
+
+}
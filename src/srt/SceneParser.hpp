@@ -0,0 +1,146 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SCENE PARSER HEADER FILE                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_SCENEPARSER_S
+#define S_SCENEPARSER_S
+
+// System includes.
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// My includes.
+#include "Animation.hpp"
+#include "Camera.hpp"
+#include "Hitable.hpp"
+#include "materials/Material.hpp"
+#include "textures/Texture.hpp"
+#include "utility/Arena.hpp"
+#include "utility/JsonReader.hpp"
+#include "utility/MappedFile.hpp"
+
+namespace srt{
+
+/// Reads a JSON scene file: its size, the camera, the background, the named textures and materials
+/// and the shapes. Every shape, material and texture is an object whose "type" selects the factory
+/// that builds it, and new types are added registering their factories before parsing.
+/// A material or a texture can also be the name of one defined in the "materials" or "textures"
+/// objects of the file: every use of a name shares the same instance.
+/// The file is streamed from memory, and a large array of shapes is parsed by more threads.
+/// The "animation" object gives the frames and the keyframes of the camera, while the translations
+/// have their own "keyframes".
+/// The shapes are created in an arena, that the scene built from the file keeps. The materials and
+/// the textures stay on the heap, so that the duplicates collapsed by the scene can be freed.
+class SceneParser{
+public:
+    // STRUCTURES
+
+    /// The camera of a scene, with the arguments of the Camera class.
+    typedef Camera::settings camera_settings;
+
+    /// The content of a scene file. If sky is false, the rays that leave the scene get the background.
+    /// The hitables are in the arena. The animation moves the translations with keyframes.
+    typedef struct sf{
+        std::string name;
+        float width, height;
+        camera_settings camera;
+        bool sky;
+        geometry::Vec3 background;
+        std::vector<std::shared_ptr<Hitable>> hitables;
+        std::shared_ptr<utility::Arena> arena;
+        Animation animation;
+    } scene_file;
+
+    // TYPEDEF
+
+    /// The factories get the parser and a reader placed before the object to read.
+    typedef std::function<std::shared_ptr<Hitable>(SceneParser &parser, utility::JsonReader &reader)> shape_factory;
+    typedef std::function<std::shared_ptr<materials::Material>(SceneParser &parser, utility::JsonReader &reader)> material_factory;
+    typedef std::function<std::shared_ptr<textures::Texture>(SceneParser &parser, utility::JsonReader &reader)> texture_factory;
+
+    // CONSTANTS
+
+    static constexpr size_t PARALLEL_SHAPES = 4096;
+
+private:
+    // ATTRIBUTES
+
+    utility::MappedFile file;
+    const char *text;
+    std::string path, directory;
+    std::unordered_map<std::string, std::shared_ptr<materials::Material>> namedMaterials;
+    std::unordered_map<std::string, std::shared_ptr<textures::Texture>> namedTextures;
+    std::shared_ptr<utility::Arena> arena;
+    Animation animation;
+    std::mutex animationMutex;
+
+    // METHODS
+
+    size_t skipObject(utility::JsonReader &reader, size_t &start) const;
+    std::string readType(const size_t start, const size_t end) const;
+    std::shared_ptr<Hitable> buildShape(const size_t start, const size_t end);
+    camera_settings readCamera(utility::JsonReader &reader, camera_settings camera, float *frame = nullptr);
+    void readAnimation(utility::JsonReader &reader, const camera_settings &still);
+    std::vector<std::shared_ptr<Hitable>> readShapes(utility::JsonReader &reader);
+
+    static std::unordered_map<std::string, shape_factory> &shapeFactories();
+    static std::unordered_map<std::string, material_factory> &materialFactories();
+    static std::unordered_map<std::string, texture_factory> &textureFactories();
+
+public:
+    // CONSTRUCTORS
+
+    SceneParser(const std::string &path);
+    SceneParser(const SceneParser &old) = delete;
+
+    // METHODS
+
+    scene_file parse();
+    std::shared_ptr<Hitable> readShape(utility::JsonReader &reader);
+    std::shared_ptr<materials::Material> readMaterial(utility::JsonReader &reader);
+    std::shared_ptr<textures::Texture> readTexture(utility::JsonReader &reader);
+    std::string resolvePath(const std::string &relativePath) const;
+
+    static void readMembers(utility::JsonReader &reader, const std::function<bool(const std::string &key)> &read);
+    static std::vector<Animation::offset_key> readKeyframes(utility::JsonReader &reader);
+    static scene_file load(const std::string &path);
+    static void registerShape(const std::string &type, const shape_factory &factory);
+    static void registerMaterial(const std::string &type, const material_factory &factory);
+    static void registerTexture(const std::string &type, const texture_factory &factory);
+
+    /**
+     * @brief Creates an object in the arena of the scene. The factories of the shapes create them with it.
+     *
+     * @param args - The arguments of the constructor of the object.
+     * @return std::shared_ptr<T> - The object.
+     */
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args){
+        return this->arena->make<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Adds the keyframes of a translation to the animation of the scene. See Animation::addTrack.
+     *
+     * @param translation - The translation or the moving translation.
+     * @param keys - The keyframes.
+     */
+    template<typename T>
+    void animate(const std::shared_ptr<T> &translation, const std::vector<Animation::offset_key> &keys){
+        std::lock_guard<std::mutex> lock(this->animationMutex);
+        this->animation.addTrack(translation, keys);
+    }
+};
+
+}
+
+#endif
@@ -12,10 +12,13 @@
 
 // Other system includes
 #include <algorithm>
+#include <cmath>
 #include <queue>
 
 // My other includes
+#include "../utility/Profiler.hpp"
 #include "../utility/Randomizer.hpp"
+#include "../utility/TraversalStats.hpp"
 #include "../geometry/shapes/AABox.hpp"
 #include "../materials/Dielectric.hpp"
 
@@ -30,7 +33,7 @@ namespace ds{
      * @brief Cretes an empty Bounding Volume Hierarchy.
      * 
      */
-    BVH::BVH(){ }
+    BVH::BVH() : parent(nullptr), t0(0), invDuration(0), isMoving(false), depth(0), count(0) { }
 
     /**
      * @brief Creates a BVH with the hitable passed as parameters.
@@ -38,34 +41,43 @@ namespace ds{
      * @param hitables - The hitable on which construct the BVH.
      * @param t0 - The first time instant to consider.
      * @param t1 - The last time instant to consider.
+     * @param arena - The arena of the nodes, owned by a shared pointer. The nodes are allocated on the heap if null.
      */
-    BVH::BVH(std::vector<std::shared_ptr<Hitable>> &hitables, const float t0, const float t1) : 
-        BVH(hitables, 0, hitables.size() - 1, t0, t1){ }
+    BVH::BVH(std::vector<std::shared_ptr<Hitable>> &hitables, const float t0, const float t1, utility::Arena *arena) : 
+        BVH(hitables, 0, hitables.size() - 1, t0, t1, arena){ }
 
+    /// Orders the hitables by the centroid of their boxes along an axis, at a given time.
     struct axis_comparator
     {        
+        short axis;
+        float time;
+
+        axis_comparator(const short axis, const float time) : axis(axis), time(time) {}
+
         inline bool operator() (const std::shared_ptr<Hitable>& hit0, const std::shared_ptr<Hitable>& hit1)
         {
-            short axis = static_cast<short>(2.99* rand_float());
-            auto box0 = hit0->getAABB(0, 0), box1 = hit0->getAABB(0, 0);
+            auto box0 = hit0->getAABB(time, time), box1 = hit1->getAABB(time, time);
 
             if(box0 == nullptr || box1 == nullptr)
                 throw std::invalid_argument("One of the hitable object has no bounding box");
             
-            return box0->getMin()[axis] > box1->getMin()[axis] ? true : false;
+            return box0->getMin()[axis] + box0->getMax()[axis] < box1->getMin()[axis] + box1->getMax()[axis];
         }
     };
 
     /**
-     * @brief Construct a new BVH::BVH object.
+     * @brief Construct a new BVH::BVH object on the hitables in the range [start, end].
      * 
-     * @param hitables 
-     * @param start 
-     * @param end 
-     * @param t0 
-     * @param t1 
+     * @param hitables - The hitables on which construct the BVH.
+     * @param start - The first hitable of the range.
+     * @param end - The last hitable of the range.
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     * @param arena - The arena of the nodes, or null.
      */
-    BVH::BVH(std::vector<std::shared_ptr<Hitable>> &hitables, size_t start, size_t end, const float t0, const float t1){
+    BVH::BVH(std::vector<std::shared_ptr<Hitable>> &hitables, size_t start, size_t end, const float t0, const float t1, 
+             utility::Arena *arena) :
+        parent(nullptr), t0(t0), invDuration(t1 > t0 ? 1 / (t1 - t0) : 0), count(end - start + 1){
         // Set left and right son.
         if(start == end){
             this->left = this->right = hitables[start]; 
@@ -77,21 +89,426 @@ namespace ds{
             this->depth = 0;
         }
         else{
-            std::sort(hitables.begin() + start, hitables.begin() + end, axis_comparator());
+            // Split on the centroids of the boxes at the middle of the time interval.
+            short axis = static_cast<short>(2.99* rand_float());
+            std::sort(hitables.begin() + start, hitables.begin() + end + 1, axis_comparator(axis, (t0 + t1) / 2));
             size_t middle = start + (end - start) / 2;
-            this->left = std::make_shared<BVH>(BVH(hitables, start, middle, t0, t1));
-            this->right = std::make_shared<BVH>(BVH(hitables, middle + 1, end, t0, t1));
+            if(arena != nullptr){
+                this->left = arena->make<BVH>(BVH(hitables, start, middle, t0, t1, arena));
+                this->right = arena->make<BVH>(BVH(hitables, middle + 1, end, t0, t1, arena));
+            }
+            else{
+                this->left = std::make_shared<BVH>(BVH(hitables, start, middle, t0, t1, arena));
+                this->right = std::make_shared<BVH>(BVH(hitables, middle + 1, end, t0, t1, arena));
+            }
             this->depth = max(static_cast<BVH *>(this->left.get())->depth, static_cast<BVH *>(this->right.get())->depth) + 1;
         }
-        
-        // Get boundig box and compute the current one.
-        const auto &leftBox = this->left->getAABB(t0, t1),
-                   &rightBox = this->right->getAABB(t0, t1);
 
-        if(leftBox == nullptr || rightBox == nullptr)
+        this->fit(t0, t1);
+    }
+
+    /**
+     * @brief Computes the boxes of the node from the boxes of its sons at the two time instants.
+     * 
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     */
+    void BVH::fit(const float t0, const float t1){
+        const auto &leftBox = this->left->getAABB(t0, t0), &leftEndBox = this->left->getAABB(t1, t1),
+                   &rightBox = this->right->getAABB(t0, t0), &rightEndBox = this->right->getAABB(t1, t1);
+
+        if(leftBox == nullptr || rightBox == nullptr || leftEndBox == nullptr || rightEndBox == nullptr)
             throw std::invalid_argument("One of the hitable object has no bounding box");
 
         this->box = leftBox->surroundingBox(*rightBox);
+        this->endBox = leftEndBox->surroundingBox(*rightEndBox);
+        this->isMoving = this->box.getMin() != this->endBox.getMin() || this->box.getMax() != this->endBox.getMax();
+    }
+
+    /**
+     * @brief Returns the sum of the surface areas of the nodes of the tree rooted at this.
+     *        The sons of a node are nodes too unless its depth is 0.
+     * 
+     * @return float - The sum of the areas.
+     */
+    float BVH::getAreaSum() const{
+        const float area = this->box.surroundingBox(this->endBox).getSurfaceArea();
+        if(this->depth == 0)    return area;
+        return area + static_cast<const BVH*>(this->left.get())->getAreaSum() + static_cast<const BVH*>(this->right.get())->getAreaSum();
+    }
+
+    /**
+     * @brief Refits the boxes of the tree rooted at this, from the leaves up.
+     * 
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     * @return float - The sum of the surface areas of the refitted nodes.
+     */
+    float BVH::refitTree(const float t0, const float t1){
+        float area = 0;
+        if(this->depth > 0)
+            area = static_cast<BVH*>(this->left.get())->refitTree(t0, t1) + static_cast<BVH*>(this->right.get())->refitTree(t0, t1);
+
+        this->fit(t0, t1);
+        return area + this->box.surroundingBox(this->endBox).getSurfaceArea();
+    }
+
+    /**
+     * @brief Returns the cost of the tree, that is the expected number of nodes visited by a ray that
+     *        hits the root: the sum of the surface areas of the nodes divided by the one of the root.
+     *        A tree refitted on leaves that moved away from each other costs more than the one built on them.
+     * 
+     * @return float - The cost of the tree.
+     */
+    float BVH::getCost() const{
+        if(this->left == nullptr)   return 0;
+
+        const float rootArea = this->box.surroundingBox(this->endBox).getSurfaceArea();
+        return rootArea > 0 ? this->getAreaSum() / rootArea : 0;
+    }
+
+    /**
+     * @brief Recomputes the boxes of the tree after the leaves have moved, keeping its structure.
+     *        The time instants must be the ones of the construction.
+     * 
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     * @return float - The sum of the surface areas of the refitted nodes, see getAreaSum.
+     */
+    float BVH::refit(const float t0, const float t1){
+        if(this->left == nullptr)   return 0;
+        return this->refitTree(t0, t1);
+    }
+
+    /**
+     * @brief Copies the nodes of the tree rooted at this, so that they can be changed without changing
+     *        the tree. The leaves are shared. The copy must be indexed before it is edited.
+     * 
+     * @param arena - The arena of the copied nodes, or null to place them on the heap.
+     * @return BVH - The root of the copy.
+     */
+    BVH BVH::clone(utility::Arena *arena) const{
+        BVH copy{*this};
+        copy.parent = nullptr;
+        if(this->depth > 0){
+            BVH left = static_cast<const BVH*>(this->left.get())->clone(arena),
+                right = static_cast<const BVH*>(this->right.get())->clone(arena);
+            if(arena != nullptr){
+                copy.left = arena->make<BVH>(std::move(left));
+                copy.right = arena->make<BVH>(std::move(right));
+            }
+            else{
+                copy.left = std::make_shared<BVH>(std::move(left));
+                copy.right = std::make_shared<BVH>(std::move(right));
+            }
+        }
+        return copy;
+    }
+
+    /**
+     * @brief Tells if the tree has no leaves, as an empty BVH or one whose leaves have all been removed.
+     * 
+     * @return true - If the tree has no leaves.
+     * @return false - Otherwise.
+     */
+    bool BVH::isEmpty() const{
+        return this->left == nullptr;
+    }
+
+    /**
+     * @brief Returns the surface area of the box of the node from the first to the last time instant.
+     * 
+     * @return float - The area.
+     */
+    float BVH::getArea() const{
+        return this->box.surroundingBox(this->endBox).getSurfaceArea();
+    }
+
+    /**
+     * @brief Returns the surface area of the box of the whole tree, 0 if it is empty.
+     * 
+     * @return float - The area.
+     */
+    float BVH::getSurfaceArea() const{
+        return this->isEmpty() ? 0 : this->getArea();
+    }
+
+    /**
+     * @brief Sets the parents of the nodes of the tree rooted at this and records the node of every leaf,
+     *        so that the leaves can be inserted and removed. It must be called again after the tree
+     *        has been built again. The sons of the root have no parent and the leaves of the root
+     *        no node, since the root can be moved with the object that owns it.
+     * 
+     * @param leaves - The index to fill.
+     */
+    void BVH::index(leaf_index &leaves){
+        if(this->isEmpty())
+            return;
+
+        if(this->depth == 0){
+            leaves[this->left.get()] = leaves[this->right.get()] = nullptr;
+            return;
+        }
+        static_cast<BVH*>(this->left.get())->indexTree(nullptr, leaves);
+        static_cast<BVH*>(this->right.get())->indexTree(nullptr, leaves);
+    }
+
+    /**
+     * @brief Used to index the tree with recursion.
+     */
+    void BVH::indexTree(BVH *parent, leaf_index &leaves){
+        this->parent = parent;
+        if(this->depth == 0){
+            leaves[this->left.get()] = leaves[this->right.get()] = this;
+            return;
+        }
+        static_cast<BVH*>(this->left.get())->indexTree(this, leaves);
+        static_cast<BVH*>(this->right.get())->indexTree(this, leaves);
+    }
+
+    /**
+     * @brief Creates a node on one or two leaves, in the arena if not null.
+     * 
+     * @param hitables - The leaves.
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     * @param arena - The arena of the nodes, or null.
+     * @return std::shared_ptr<BVH> - The node.
+     */
+    std::shared_ptr<BVH> BVH::makeNode(std::vector<std::shared_ptr<Hitable>> hitables, const float t0, const float t1, 
+                                       utility::Arena *arena){
+        if(arena != nullptr)    return arena->make<BVH>(BVH(hitables, 0, hitables.size() - 1, t0, t1, arena));
+        return std::make_shared<BVH>(BVH(hitables, 0, hitables.size() - 1, t0, t1, arena));
+    }
+
+    /**
+     * @brief Refits the boxes, the depths and the leaf counts of the nodes from a node of the tree up to the root, that is this.
+     * 
+     * @param node - The first node, or null for the root.
+     * @param t0 - The first time instant to consider.
+     * @param t1 - The last time instant to consider.
+     * @return float - How much the sum of the surface areas of the nodes has changed.
+     */
+    float BVH::refitPath(BVH *node, const float t0, const float t1){
+        float delta = 0;
+        for(node = node != nullptr ? node : this; ; node = node->parent != nullptr ? node->parent : this){
+            const float area = node->getArea();
+            node->fit(t0, t1);
+            if(node->depth > 0){
+                const BVH *const left = static_cast<BVH*>(node->left.get()), *const right = static_cast<BVH*>(node->right.get());
+                node->depth = max(left->depth, right->depth) + 1;
+                node->count = left->count + right->count;
+            }
+            else
+                node->count = node->left == node->right ? 1 : 2;
+            delta += node->getArea() - area;
+            if(node == this)    return delta;
+        }
+    }
+
+    /**
+     * @brief Inserts a leaf in the tree rooted at this, going down to the sons whose boxes grow less. 
+     *        Only the nodes on the path of the leaf change, but the tree is worse than the one built 
+     *        on all the leaves: see getCost. The tree must have been indexed.
+     * 
+     * @param hitable - The leaf.
+     * @param t0 - The first time instant to consider, the one of the construction.
+     * @param t1 - The last time instant to consider, the one of the construction.
+     * @param arena - The arena of the nodes of the tree, or null.
+     * @param leaves - The index of the tree, updated.
+     * @return float - How much the sum of the surface areas of the nodes has changed.
+     */
+    float BVH::insert(const std::shared_ptr<Hitable> &hitable, const float t0, const float t1, utility::Arena *arena, 
+                      leaf_index &leaves){
+        const auto hitableBox = hitable->getAABB(t0, t1);
+        if(hitableBox == nullptr)
+            throw std::invalid_argument("The hitable object has no bounding box");
+
+        if(this->isEmpty()){
+            this->t0 = t0;
+            this->invDuration = t1 > t0 ? 1 / (t1 - t0) : 0;
+            this->left = this->right = hitable;
+            this->depth = 0;
+            this->count = 1;
+            leaves[hitable.get()] = nullptr;
+            this->fit(t0, t1);
+            return this->getArea();
+        }
+
+        // The growth of the area of the box of a son that takes the leaf.
+        const auto growth = [&hitableBox, t0, t1](const Hitable &son){
+            const geometry::AABB sonBox = *son.getAABB(t0, t1);
+            return sonBox.surroundingBox(*hitableBox).getSurfaceArea() - sonBox.getSurfaceArea();
+        };
+
+        BVH *node = this;
+        while(node->depth > 0)
+            node = static_cast<BVH*>(growth(*node->left) <= growth(*node->right) ? node->left.get() : node->right.get());
+
+        BVH *const key = node == this ? nullptr : node;
+        float delta = 0;
+        if(node->left == node->right){
+            node->right = hitable;
+            leaves[hitable.get()] = key;
+        }
+        else{
+            // The leaf joins the closer of the two leaves of the node, that become two nodes.
+            const bool toLeft = growth(*node->left) <= growth(*node->right);
+            const std::shared_ptr<Hitable> closer = toLeft ? node->left : node->right, other = toLeft ? node->right : node->left;
+            const std::shared_ptr<BVH> pair = makeNode({closer, hitable}, t0, t1, arena), single = makeNode({other}, t0, t1, arena);
+            pair->parent = single->parent = key;
+            leaves[closer.get()] = leaves[hitable.get()] = pair.get();
+            leaves[other.get()] = single.get();
+            node->left = pair;
+            node->right = single;
+            node->depth = 1;
+            delta += pair->getArea() + single->getArea();
+        }
+
+        delta += this->refitPath(key, t0, t1);
+        return delta + this->rebalance(key, t0, t1, arena, leaves);
+    }
+
+    /**
+     * @brief Removes a leaf from the tree rooted at this. Only the nodes on the path of the leaf change,
+     *        unless the tree is rebalanced. The nodes removed are not freed if they are in an arena. 
+     *        The tree must have been indexed.
+     * 
+     * @param hitable - The leaf.
+     * @param t0 - The first time instant to consider, the one of the construction.
+     * @param t1 - The last time instant to consider, the one of the construction.
+     * @param arena - The arena of the nodes of the tree, or null.
+     * @param leaves - The index of the tree, updated.
+     * @return float - How much the sum of the surface areas of the nodes has changed.
+     */
+    float BVH::remove(const Hitable *hitable, const float t0, const float t1, utility::Arena *arena, leaf_index &leaves){
+        const auto it = leaves.find(hitable);
+        if(it == leaves.end())
+            throw std::invalid_argument("The hitable object is not in the tree");
+
+        BVH *const key = it->second, *const node = key != nullptr ? key : this;
+        leaves.erase(it);
+
+        // The node keeps its other leaf.
+        if(node->left != node->right){
+            if(node->left.get() == hitable)     node->left = node->right;
+            else                                node->right = node->left;
+            const float delta = this->refitPath(key, t0, t1);
+            return delta + this->rebalance(key, t0, t1, arena, leaves);
+        }
+
+        // The last leaf of the tree.
+        if(node == this){
+            const float area = this->getArea();
+            *this = BVH();
+            return -area;
+        }
+
+        // The node goes away, and its brother takes the place of their parent.
+        BVH *const parent = node->parent != nullptr ? node->parent : this;
+        const std::shared_ptr<Hitable> brother = parent->left.get() == node ? parent->right : parent->left;
+        BVH *const brotherNode = static_cast<BVH*>(brother.get());
+
+        if(parent == this){
+            const float delta = -node->getArea() - brotherNode->getArea();
+            // The root is not owned by a pointer, so it takes the sons of the brother.
+            this->left = brotherNode->left;
+            this->right = brotherNode->right;
+            this->depth = brotherNode->depth;
+            this->count = brotherNode->count;
+            if(this->depth == 0){
+                leaves[this->left.get()] = leaves[this->right.get()] = nullptr;
+            }
+            else{
+                static_cast<BVH*>(this->left.get())->parent = nullptr;
+                static_cast<BVH*>(this->right.get())->parent = nullptr;
+            }
+            return delta + this->refitPath(nullptr, t0, t1);
+        }
+
+        const float delta = -node->getArea() - parent->getArea();
+        BVH *const grandparent = parent->parent != nullptr ? parent->parent : this;
+        brotherNode->parent = parent->parent;
+        if(grandparent->left.get() == parent)   grandparent->left = brother;
+        else                                    grandparent->right = brother;
+        const float refitDelta = this->refitPath(brotherNode->parent, t0, t1);
+        return delta + refitDelta + this->rebalance(brotherNode->parent, t0, t1, arena, leaves);
+    }
+
+    /**
+     * @brief Tells if the node is too deep for the number of its leaves, see MAX_IMBALANCE.
+     * 
+     * @return true - If its subtree has to be built again.
+     * @return false - Otherwise.
+     */
+    bool BVH::isUnbalanced() const{
+        return this->depth > 0 && this->depth > MAX_IMBALANCE * log2(static_cast<float>(this->count));
+    }
+
+    /**
+     * @brief Adds the leaves of the tree rooted at this to a vector.
+     * 
+     * @param hitables - The vector.
+     */
+    void BVH::collectLeaves(std::vector<std::shared_ptr<Hitable>> &hitables) const{
+        if(this->depth > 0){
+            static_cast<const BVH*>(this->left.get())->collectLeaves(hitables);
+            static_cast<const BVH*>(this->right.get())->collectLeaves(hitables);
+            return;
+        }
+        hitables.push_back(this->left);
+        if(this->right != this->left)   hitables.push_back(this->right);
+    }
+
+    /**
+     * @brief Builds again the subtree of the highest unbalanced node from a node of the tree up to the root, 
+     *        that is this, if one. The depths and the leaf counts of the path must be up to date.
+     * 
+     * @param node - The first node, or null for the root.
+     * @param t0 - The first time instant to consider, the one of the construction.
+     * @param t1 - The last time instant to consider, the one of the construction.
+     * @param arena - The arena of the nodes of the tree, or null.
+     * @param leaves - The index of the tree, updated.
+     * @return float - How much the sum of the surface areas of the nodes has changed.
+     */
+    float BVH::rebalance(BVH *node, const float t0, const float t1, utility::Arena *arena, leaf_index &leaves){
+        BVH *highest = nullptr;
+        for(node = node != nullptr ? node : this; ; node = node->parent != nullptr ? node->parent : this){
+            if(node->isUnbalanced())    highest = node;
+            if(node == this)    break;
+        }
+        if(highest == nullptr)
+            return 0;
+
+        utility::Profiler::Zone zone{"BVH rebalance"};
+        std::vector<std::shared_ptr<Hitable>> hitables;
+        highest->collectLeaves(hitables);
+        const float areaSum = highest->getAreaSum();
+
+        if(highest == this){
+            *this = BVH(hitables, 0, hitables.size() - 1, t0, t1, arena);
+            this->index(leaves);
+            return this->getAreaSum() - areaSum;
+        }
+
+        // The new subtree takes the place of the old one, whose nodes may be freed.
+        BVH *const key = highest->parent, *const parent = key != nullptr ? key : this;
+        const std::shared_ptr<BVH> subtree = makeNode(hitables, t0, t1, arena);
+        if(parent->left.get() == highest)   parent->left = subtree;
+        else                                parent->right = subtree;
+        subtree->indexTree(key, leaves);
+        return subtree->getAreaSum() - areaSum + this->refitPath(key, t0, t1);
+    }
+
+    /**
+     * @brief Returns the box that surrounds all the leaves at a given time, interpolating the 
+     *        boxes at the first and at the last time instant.
+     * 
+     * @param time - The time instant.
+     * @return geometry::AABB - The box at that time.
+     */
+    geometry::AABB BVH::getBoxAt(const float time) const{
+        return this->isMoving ? this->box.interpolate(this->endBox, (time - this->t0) * this->invDuration) : this->box;
     }
 
     /**
@@ -103,6 +520,15 @@ namespace ds{
         return this->depth;
     }
 
+    /**
+     * @brief Gets the number of leaves of the tree rooted at this.
+     * 
+     * @return const size_t& - The number of leaves.
+     */
+    const size_t& BVH::getLeafCount() const{
+        return this->count;
+    }
+
     /**
      * @brief Computes if the ray intersect one of the leaves of the tree.
      * 
@@ -112,9 +538,12 @@ namespace ds{
      * @return Hitable::hit_record - The record with the info about the hit object, if one.
      */
     Hitable::hit_record BVH::intersection(const Ray &ray, const float tmin, const float tmax) const{
-        if(box.hit(ray, tmin, tmax)){
+        SRT_COUNT_NODE();
+        if(this->getBoxAt(ray.getTime()).hit(ray, tmin, tmax)){
+            // The right son only needs to be tested up to the left hit, so that its boxes 
+            // behind the hit are culled by the slab test.
             Hitable::hit_record leftHit = this->left->intersection(ray, tmin, tmax),
-                                rightHit = this->right->intersection(ray, tmin, tmax);
+                                rightHit = this->right->intersection(ray, tmin, leftHit.hit ? leftHit.t : tmax);
 
             // If both sons are hit, return the closer one.
             if(leftHit.hit && rightHit.hit)
@@ -129,14 +558,24 @@ namespace ds{
     }
 
     /**
-     * @brief Returns the boundig box that surrounds all the leaves.
+     * @brief Returns the boundig box that surrounds all the leaves from t0 to t1.
      * 
      * @param t0 - The first time instant to consider.
      * @param t1 - The last time instant to consider.
      * @return std::unique_ptr<geometry::AABB> - The axis aligned bounding box.
      */
     std::unique_ptr<geometry::AABB> BVH::getAABB(const float t0, const float t1) const{
-        return std::make_unique<geometry::AABB>(this->box);
+        return std::make_unique<geometry::AABB>(this->getBoxAt(t0).surroundingBox(this->getBoxAt(t1)));
+    }
+
+    /**
+     * @brief Adds the materials of all the leaves to the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void BVH::bindMaterials(materials::MaterialTable &table){
+        if(this->left != nullptr)   this->left->bindMaterials(table);
+        if(this->right != nullptr && this->right != this->left)  this->right->bindMaterials(table);
     }
 
     std::shared_ptr<Hitable> getShapeFromBox(const geometry::AABB &box, const int level){
@@ -158,7 +597,7 @@ namespace ds{
     void BVH::draw_slave(std::vector<std::shared_ptr<Hitable>> &squares, const int level) const{
 
         // Add rectangle.
-        squares.push_back(getShapeFromBox(this->box, level));
+        squares.push_back(getShapeFromBox(this->box.surroundingBox(this->endBox), level));
 
         // Check if the function need to be recalled on children.
         if (const BVH* leftSon = dynamic_cast<BVH*>(&*this->left))
@@ -10,37 +10,89 @@
 #ifndef S_DS_BVH_S
 #define S_DS_BVH_S
 
+// System includes
+#include <unordered_map>
+
 // My includes
 #include "../Hitable.hpp"
 #include "../geometry/AABB.hpp"
+#include "../utility/Arena.hpp"
 
 namespace srt{
 namespace ds{
 
 /// This class represents a bounding volume hierarchy composed by a tree structure in which every
 /// node is a AABB and the leaves are the true hitable objects.
+/// Every node stores the box of its leaves at the first and at the last time instant considered, 
+/// and during the traversal the box is linearly interpolated at the time of the ray. In this way
+/// moving objects do not make the boxes cover their whole path. Leaves are assumed to move linearly.
+/// The nodes can be placed in an arena, next to each other, in place of the heap.
+/// When the leaves move but stay the same, the boxes can be refitted without building the tree again.
+/// Single leaves can be inserted and removed too, changing only the nodes on their path to the root:
+/// this needs the parents of the nodes and the nodes of the leaves, that are found once by index().
+/// The sons of a node are two nodes, or two leaves if its depth is 0; a node may hold a single leaf.
+/// The edits keep the tree balanced: when a node on the path of an edit gets deeper than MAX_IMBALANCE
+/// times the logarithm of its leaves, the subtree of the highest such node is built again, so the depth
+/// stays logarithmic and a rebuild is paid by the edits that made it needed.
 class BVH : public Hitable{
+public:
+    // CONSTANTS
+
+    static constexpr float MAX_IMBALANCE = 2;
+
+    // STRUCTURES
+
+    /// The node that holds every leaf of a tree, null for the root.
+    typedef std::unordered_map<const Hitable*, BVH*> leaf_index;
+
 private:
     // ATTRIBUTES
 
     std::shared_ptr<Hitable> left, right;
-    geometry::AABB box;
-    size_t depth;
+    BVH *parent;
+    geometry::AABB box, endBox;
+    float t0, invDuration;
+    bool isMoving;
+    size_t depth, count;
  
     // METHODS
-    BVH(std::vector<std::shared_ptr<Hitable>> &hitables, size_t start, size_t end, const float t0, const float t1);
+    geometry::AABB getBoxAt(const float time) const;
+    void fit(const float t0, const float t1);
+    float refitTree(const float t0, const float t1);
+    float getArea() const;
+    void indexTree(BVH *parent, leaf_index &leaves);
+    float refitPath(BVH *node, const float t0, const float t1);
+    bool isUnbalanced() const;
+    void collectLeaves(std::vector<std::shared_ptr<Hitable>> &hitables) const;
+    float rebalance(BVH *node, const float t0, const float t1, utility::Arena *arena, leaf_index &leaves);
+    static std::shared_ptr<BVH> makeNode(std::vector<std::shared_ptr<Hitable>> hitables, const float t0, const float t1,
+                                         utility::Arena *arena);
+    BVH(std::vector<std::shared_ptr<Hitable>> &hitables, size_t start, size_t end, const float t0, const float t1, 
+        utility::Arena *arena);
     void draw_slave(std::vector<std::shared_ptr<Hitable>> &squares, const int level) const;
 public:
     // CONSTRUCTORS
 
     BVH();
-    BVH(std::vector<std::shared_ptr<Hitable>> &hitables, const float t0, const float t1);
+    BVH(std::vector<std::shared_ptr<Hitable>> &hitables, const float t0, const float t1, utility::Arena *arena = nullptr);
 
     // METHODS
 
     const size_t &getDepth() const;
+    const size_t &getLeafCount() const;
+    float getAreaSum() const;
+    float getCost() const;
+    float refit(const float t0, const float t1);
+    BVH clone(utility::Arena *arena) const;
+    bool isEmpty() const;
+    float getSurfaceArea() const;
+    void index(leaf_index &leaves);
+    float insert(const std::shared_ptr<Hitable> &hitable, const float t0, const float t1, utility::Arena *arena, 
+                 leaf_index &leaves);
+    float remove(const Hitable *hitable, const float t0, const float t1, utility::Arena *arena, leaf_index &leaves);
     Hitable::hit_record intersection(const Ray &ray, const float tmin, const float tmax) const;
     std::unique_ptr<geometry::AABB> getAABB(const float t0, const float t1) const;
+    void bindMaterials(materials::MaterialTable &table);
     std::vector<std::shared_ptr<Hitable>> draw() const;
 };
 
@@ -0,0 +1,295 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  FLAT BVH CLASS FILE                                *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "../src/srt/srt.h"
+#include "FlatBVH.hpp"
+
+// Other system includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// My other includes
+#include "../utility/TraversalStats.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+using namespace srt::materials;
+
+namespace srt{
+namespace ds{
+
+    /**
+     * @brief Builds the hierarchy of the spheres, splitting them at the median of the centers along
+     *        the widest axis until a leaf has at most LEAF_SIZE spheres.
+     *
+     * @param spheres - The spheres.
+     * @param palette - The materials referred by the spheres.
+     */
+    FlatBVH::FlatBVH(const vector<sphere> &spheres, const vector<shared_ptr<Material>> &palette) :
+        ownedSpheres(spheres), palette(palette), materialIds(palette.size(), MaterialTable::NO_MATERIAL_ID){
+        for(const sphere &s : spheres)
+            if(s.material >= palette.size())
+                throw std::invalid_argument("A sphere refers to a material that does not exist");
+
+        if(!this->ownedSpheres.empty())
+            this->build(0, this->ownedSpheres.size(), 0);
+
+        this->nodes = this->ownedNodes.data();
+        this->nodeCount = this->ownedNodes.size();
+        this->spheres = this->ownedSpheres.data();
+        this->sphereCount = this->ownedSpheres.size();
+    }
+
+    /**
+     * @brief Uses a hierarchy already built, whose arrays are not copied. The arrays are checked, so
+     *        that a corrupted hierarchy cannot be traversed out of its bounds.
+     *
+     * @param nodes - The nodes, in depth first order.
+     * @param nodeCount - The number of nodes.
+     * @param spheres - The spheres, sorted by leaf.
+     * @param sphereCount - The number of spheres.
+     * @param palette - The materials referred by the spheres.
+     * @param storage - The owner of the arrays, kept as long as the hierarchy.
+     */
+    FlatBVH::FlatBVH(const node *nodes, const size_t nodeCount, const sphere *spheres, const size_t sphereCount,
+                     const vector<shared_ptr<Material>> &palette, const shared_ptr<const void> &storage) :
+        storage(storage), nodes(nodes), spheres(spheres), nodeCount(nodeCount), sphereCount(sphereCount),
+        palette(palette), materialIds(palette.size(), MaterialTable::NO_MATERIAL_ID){
+        if((nodeCount == 0) != (sphereCount == 0))
+            throw std::invalid_argument("The hierarchy is not valid");
+
+        // The children follow their parent, so the depths are known when a node is checked. Every node but the
+        // root must be the child of exactly one node: a node shared by two parents would make the hierarchy a
+        // graph, whose paths are longer than the depths seen here.
+        vector<size_t> depths(nodeCount, 0);
+        vector<bool> reached(nodeCount, false);
+        if(nodeCount > 0)
+            reached[0] = true;
+        for(size_t i = 0; i < nodeCount; ++i){
+            const node &n = nodes[i];
+            const bool valid = reached[i] && (n.count > 0 ? n.offset <= sphereCount && n.count <= sphereCount - n.offset
+                                                          : n.offset > i + 1 && n.offset < nodeCount && !reached[i + 1] &&
+                                                            !reached[n.offset] && depths[i] + 1 < MAX_DEPTH);
+            if(!valid)
+                throw std::invalid_argument("The hierarchy is not valid");
+            if(n.count == 0){
+                reached[i + 1] = reached[n.offset] = true;
+                depths[i + 1] = depths[n.offset] = depths[i] + 1;
+            }
+        }
+        for(size_t i = 0; i < sphereCount; ++i)
+            if(spheres[i].material >= palette.size())
+                throw std::invalid_argument("A sphere refers to a material that does not exist");
+    }
+
+    /**
+     * @brief Appends the subtree of the spheres in the range [start, end) to the nodes.
+     *
+     * @param start - The first sphere.
+     * @param end - The sphere after the last one.
+     * @param depth - The depth of the subtree.
+     * @return uint32_t - The index of the root of the subtree.
+     */
+    uint32_t FlatBVH::build(const uint32_t start, const uint32_t end, const size_t depth){
+        const uint32_t index = this->ownedNodes.size();
+        node current{{numeric_limits<float>::max(), numeric_limits<float>::max(), numeric_limits<float>::max()},
+                     {-numeric_limits<float>::max(), -numeric_limits<float>::max(), -numeric_limits<float>::max()}, start, end - start};
+        float lower[3] = {numeric_limits<float>::max(), numeric_limits<float>::max(), numeric_limits<float>::max()},
+              upper[3] = {-numeric_limits<float>::max(), -numeric_limits<float>::max(), -numeric_limits<float>::max()};
+
+        for(uint32_t i = start; i < end; ++i){
+            const sphere &s = this->ownedSpheres[i];
+            const float radius = std::abs(s.radius);
+            for(int axis = 0; axis < 3; ++axis){
+                current.min[axis] = min(current.min[axis], s.center[axis] - radius);
+                current.max[axis] = max(current.max[axis], s.center[axis] + radius);
+                lower[axis] = min(lower[axis], s.center[axis]);
+                upper[axis] = max(upper[axis], s.center[axis]);
+            }
+        }
+        this->ownedNodes.push_back(current);
+
+        if(end - start <= LEAF_SIZE || depth + 1 >= MAX_DEPTH)
+            return index;
+
+        const float extent[3] = {upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2]};
+        const int axis = extent[0] > extent[1] ? (extent[0] > extent[2] ? 0 : 2) : (extent[1] > extent[2] ? 1 : 2);
+        const uint32_t middle = start + (end - start) / 2;
+        nth_element(this->ownedSpheres.begin() + start, this->ownedSpheres.begin() + middle, this->ownedSpheres.begin() + end,
+                    [axis](const sphere &a, const sphere &b){ return a.center[axis] < b.center[axis]; });
+
+        this->build(start, middle, depth + 1);
+        const uint32_t right = this->build(middle, end, depth + 1);
+        this->ownedNodes[index].offset = right;
+        this->ownedNodes[index].count = 0;
+        return index;
+    }
+
+    /**
+     * @brief Returns the nodes.
+     *
+     * @return const node* - The nodes, in depth first order.
+     */
+    const FlatBVH::node *FlatBVH::getNodes() const{
+        return this->nodes;
+    }
+
+    /**
+     * @brief Returns the number of nodes.
+     *
+     * @return size_t - The number of nodes.
+     */
+    size_t FlatBVH::getNodeCount() const{
+        return this->nodeCount;
+    }
+
+    /**
+     * @brief Returns the spheres.
+     *
+     * @return const sphere* - The spheres, sorted by leaf.
+     */
+    const FlatBVH::sphere *FlatBVH::getSpheres() const{
+        return this->spheres;
+    }
+
+    /**
+     * @brief Returns the number of spheres.
+     *
+     * @return size_t - The number of spheres.
+     */
+    size_t FlatBVH::getSphereCount() const{
+        return this->sphereCount;
+    }
+
+    /**
+     * @brief Returns the materials referred by the spheres.
+     *
+     * @return const std::vector<std::shared_ptr<materials::Material>>& - The materials.
+     */
+    const vector<shared_ptr<Material>> &FlatBVH::getPalette() const{
+        return this->palette;
+    }
+
+    /**
+     * @brief Returns the nearest intersection between a ray and the spheres. The nodes are visited
+     *        with a stack, and the ones farther than the nearest hit found so far are skipped.
+     *
+     * @param ray - The ray.
+     * @param tmin - The lower t to consider.
+     * @param tmax - The greater t to consider.
+     * @return Hitable::hit_record - The record, whose index is the index of the sphere hit.
+     */
+    Hitable::hit_record FlatBVH::intersection(const Ray &ray, const float tmin, const float tmax) const{
+        if(this->nodeCount == 0)    return Hitable::NO_HIT;
+
+        const Vec3 &o = ray.getOrigin(), &d = ray.getDirection(), &inv = ray.getInvDirection();
+        const uint8_t *sign = ray.getSign();
+        const float a = d ^ 2;
+        uint32_t stack[MAX_DEPTH + 1];
+        size_t top = 0;
+        float best = tmax;
+        uint32_t nearest = UINT32_MAX;
+
+        stack[top++] = 0;
+        while(top > 0){
+            const uint32_t index = stack[--top];
+            const node &n = this->nodes[index];
+            const float *bounds[2] = {n.min, n.max};
+            float near = tmin, far = best;
+            SRT_COUNT_NODE();
+
+            // The same slab test of the boxes, on the arrays of the node.
+            for(int axis = 0; axis < 3; ++axis){
+                const float t0 = (bounds[sign[axis]][axis] - o[axis]) * inv[axis];
+                const float t1 = (bounds[1 - sign[axis]][axis] - o[axis]) * inv[axis];
+                near = t0 > near ? t0 : near;
+                far = t1 < far ? t1 : far;
+            }
+            if(near > far)  continue;
+
+            if(n.count == 0){
+                stack[top++] = n.offset;
+                stack[top++] = index + 1;
+                continue;
+            }
+
+            SRT_COUNT_PRIMITIVES(n.count);
+            for(uint32_t i = n.offset; i < n.offset + n.count; ++i){
+                // The same solution of the spheres, so that a cached scene is rendered in the same way.
+                const sphere &s = this->spheres[i];
+                const Vec3 dist{o.x() - s.center[0], o.y() - s.center[1], o.z() - s.center[2]};
+                const float b = 2. * (d * dist);
+                const float c = (dist ^ 2) - s.radius * s.radius;
+                const float delta = b * b - 4 * a * c;
+                if(delta <= 0)  continue;
+
+                const float q = b < 0 ? -0.5 * (b - sqrt(delta)) : -0.5 * (b + sqrt(delta));
+                const float t0 = q / a, t1 = c / q;
+                const float t = t0 > 0 && t1 > 0 ? min(t0, t1) : max(t0, t1);
+                if(t >= tmin && t <= best){
+                    best = t;
+                    nearest = i;
+                }
+            }
+        }
+
+        if(nearest == UINT32_MAX)   return Hitable::NO_HIT;
+
+        const sphere &s = this->spheres[nearest];
+        const Vec3 point = ray.getPoint(best), center{s.center[0], s.center[1], s.center[2]};
+        return {true, best, this, point, (point - center) / s.radius, this->materialIds[s.material], nearest};
+    }
+
+    /**
+     * @brief Interns the materials of the spheres in the table of the scene.
+     *
+     * @param table - The table of the materials.
+     */
+    void FlatBVH::bindMaterials(MaterialTable &table){
+        for(size_t i = 0; i < this->palette.size(); ++i)
+            this->materialIds[i] = table.intern(this->palette[i]);
+    }
+
+    /**
+     * @brief Returns the box of the root.
+     *
+     * @param t0 - The first instant of time to consider (the spheres do not move).
+     * @param t1 - The last instant of time to consider.
+     * @return std::unique_ptr<geometry::AABB> - The box surrounding all the spheres.
+     */
+    unique_ptr<AABB> FlatBVH::getAABB(const float t0, const float t1) const{
+        if(this->nodeCount == 0)    return make_unique<AABB>();
+        const node &root = this->nodes[0];
+        return make_unique<AABB>(Vec3{root.min[0], root.min[1], root.min[2]}, Vec3{root.max[0], root.max[1], root.max[2]});
+    }
+
+    /**
+     * @brief Returns the u/v coords of a sphere in a given point.
+     *
+     * @param p - The point hit in the sphere.
+     * @param index - The index of the sphere hit.
+     * @return geometry::Vec3 - The vector in which x = u, y = v and z = the texture scale.
+     */
+    Vec3 FlatBVH::getTextureCoords(const Vec3 &p, const uint32_t index) const{
+        const sphere &s = this->spheres[index];
+        const Vec3 n = (p - Vec3{s.center[0], s.center[1], s.center[2]}) / s.radius;
+        // Compute the phi and theta angle.
+        float phi = atan2(n.z(), n.x()), theta = asin(max(-1.f, min(1.f, n.y())));
+        // Compute the u and v coords.
+        float u = 1 - (phi + M_PI) / (2 * M_PI),
+              v = (theta + M_PI / 2) / M_PI;
+
+        // Half of the circumference covers the whole v range.
+        return{u, v, static_cast<float>(1 / (M_PI * std::abs(s.radius)))};
+    }
+
+}
+}
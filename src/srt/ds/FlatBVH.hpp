@@ -0,0 +1,89 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  FLAT BVH HEADER FILE                               *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_DS_FLATBVH_S
+#define S_DS_FLATBVH_S
+
+// System includes.
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// My includes
+#include "../Hitable.hpp"
+
+namespace srt{
+namespace ds{
+
+/// A bounding volume hierarchy of static spheres stored in two flat arrays, the nodes in depth first
+/// order and the spheres sorted by leaf, so that it is traversed with a stack of indices instead of
+/// virtual calls. The arrays do not contain pointers: they can be built in memory or used in place
+/// from a mapped file, that is kept alive by the hierarchy.
+class FlatBVH : public Hitable{
+public:
+    // CONSTANTS
+
+    static constexpr uint32_t LEAF_SIZE = 4;
+    static constexpr size_t MAX_DEPTH = 64;
+
+    // STRUCTURES
+
+    /// A node. The left child of an inner node follows it, while offset is the index of the right one.
+    /// A leaf has count > 0 and its spheres start at offset.
+    typedef struct n{
+        float min[3], max[3];
+        uint32_t offset, count;
+    } node;
+
+    /// A sphere, whose material is the index in the materials of the hierarchy.
+    typedef struct s{
+        float center[3], radius;
+        uint32_t material;
+    } sphere;
+
+private:
+    // ATTRIBUTES
+
+    std::vector<node> ownedNodes;
+    std::vector<sphere> ownedSpheres;
+    std::shared_ptr<const void> storage;
+    const node *nodes;
+    const sphere *spheres;
+    size_t nodeCount, sphereCount;
+    std::vector<std::shared_ptr<materials::Material>> palette;
+    std::vector<uint32_t> materialIds;
+
+    // METHODS
+
+    uint32_t build(const uint32_t start, const uint32_t end, const size_t depth);
+
+public:
+    // CONSTRUCTORS
+
+    FlatBVH(const std::vector<sphere> &spheres, const std::vector<std::shared_ptr<materials::Material>> &palette);
+    FlatBVH(const node *nodes, const size_t nodeCount, const sphere *spheres, const size_t sphereCount,
+            const std::vector<std::shared_ptr<materials::Material>> &palette, const std::shared_ptr<const void> &storage);
+
+    // METHODS
+
+    const node *getNodes() const;
+    size_t getNodeCount() const;
+    const sphere *getSpheres() const;
+    size_t getSphereCount() const;
+    const std::vector<std::shared_ptr<materials::Material>> &getPalette() const;
+    virtual Hitable::hit_record intersection(const Ray &ray, const float tmin, const float tmax) const;
+    virtual void bindMaterials(materials::MaterialTable &table);
+    virtual std::unique_ptr<geometry::AABB> getAABB(const float t0, const float t1) const;
+    virtual geometry::Vec3 getTextureCoords(const geometry::Vec3 &p, const uint32_t index = 0) const;
+};
+
+}
+}
+
+#endif
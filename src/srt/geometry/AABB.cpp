@@ -48,7 +48,11 @@ namespace geometry{
     }
 
     /**
-     * @brief Computes if a ray hit the counding box using the slab methods.
+     * @brief Computes if a ray hit the bounding box using the slab method. The near and far planes
+     *        of every slab are selected by the signs of the ray, and the distances are computed with 
+     *        the inverse direction, so that there are no divisions nor branches. 
+     *        The min and max are written so that a NaN distance, obtained when the origin lies on 
+     *        a plane parallel to the ray (0 * inf), leaves the interval untouched.
      * 
      * @param ray - The ray.
      * @param tmin - The lower t to consider.
@@ -57,22 +61,19 @@ namespace geometry{
      * @return false - If the ray does not it the aabb.
      */
     bool AABB::hit(const srt::Ray &ray, float tmin, float tmax) const{
-        for(uint8_t i = 0; i < 3; ++i){
-            // Compute intersection point.
-            const float invD = 1 / ray.getDirection()[i];
-            float t0 = (this->min[i] - ray.getOrigin()[i]) * invD;
-            float t1 = (this->max[i] - ray.getOrigin()[i]) * invD;
+        const Vec3 &origin = ray.getOrigin(), &invDirection = ray.getInvDirection();
+        const uint8_t *sign = ray.getSign();
+        const Vec3 *bounds[2] = {&this->min, &this->max};
 
-            if(invD < 0)    std::swap(t0, t1);
+        for(uint8_t i = 0; i < 3; ++i){
+            const float t0 = ((*bounds[sign[i]])[i] - origin[i]) * invDirection[i];
+            const float t1 = ((*bounds[1 - sign[i]])[i] - origin[i]) * invDirection[i];
 
-            // Compute the greater min and lower max.
+            // If the comparison fails because of a NaN the old value is kept.
             tmin = t0 > tmin ? t0 : tmin;
             tmax = t1 < tmax ? t1 : tmax;
-
-            // Return false if the intervals does not intersect.
-            if(tmax <= tmin)    return false;
         }
-        return true;
+        return tmin <= tmax;
     }
 
     /**
@@ -90,5 +91,29 @@ namespace geometry{
                  std::max(this->max.z(), box.max.z())};
         return AABB{lrc, ulc};
     }
+
+    /**
+     * @brief Returns the box obtained linearly interpolating the corners of the current aabb
+     *        and the passed one. It is used to get the box of a linearly moving object at a given time.
+     * 
+     * @param box - The box reached when alpha is 1.
+     * @param alpha - The interpolation factor, 0 returns the current box and 1 the passed one.
+     * @return AABB - The interpolated aabb.
+     */
+    AABB AABB::interpolate(const AABB &box, const float alpha) const{
+        return AABB{this->min + alpha * (box.min - this->min), this->max + alpha * (box.max - this->max)};
+    }
+
+    /**
+     * @brief Returns the area of the surface of the box, proportional to the probability that a
+     *        random ray hits it.
+     * 
+     * @return float - The surface area.
+     */
+    float AABB::getSurfaceArea() const{
+        const Vec3 size = this->max - this->min;
+        return 2 * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+    }
+
+}
 }
-}
\ No newline at end of file
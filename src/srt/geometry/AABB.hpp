@@ -40,6 +40,8 @@ public:
     const Vec3 &getMax() const;
     bool hit(const srt::Ray &ray, float tmin, float tmax) const;
     AABB surroundingBox(const AABB &box) const;
+    AABB interpolate(const AABB &box, const float alpha) const;
+    float getSurfaceArea() const;
 };
 
 }
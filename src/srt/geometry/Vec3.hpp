@@ -12,7 +12,7 @@
 
 #ifdef _WIN32
 #define VM_INLINE inline
-#elif
+#else
 #define VM_INLINE __attribute__((always_inline))
 #endif
 
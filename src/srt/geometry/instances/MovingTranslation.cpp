@@ -0,0 +1,122 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MOVING TRANSLATION CLASS FILE                      *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "MovingTranslation.hpp"
+
+namespace srt{
+namespace geometry{
+namespace instances{
+
+    /**
+     * @brief Constructs a new Moving Translation object.
+     * 
+     * @param object - The object to move.
+     * @param offset0 - The offset of the object at time t0.
+     * @param offset1 - The offset of the object at time t1.
+     * @param t0 - The time at which the object is translated by offset0.
+     * @param t1 - The time at which the object is translated by offset1.
+     */
+    MovingTranslation::MovingTranslation(const std::shared_ptr<Hitable> object, const Vec3 &offset0, 
+        const Vec3 &offset1, const float t0, const float t1) : 
+        object(object), offset0(offset0), offset1(offset1), t0(t0), t1(t1){ }
+
+    /**
+     * @brief Returns the offset of the object at a given time.
+     * 
+     * @param time - The time instant.
+     * @return Vec3 - The offset at that time.
+     */
+    Vec3 MovingTranslation::getOffsetAt(const float time) const{
+        return this->offset0 + ((time - this->t0) / (this->t1 - this->t0)) * (this->offset1 - this->offset0);
+    }
+
+    /**
+     * @brief Changes the path of the object. The BVH that contains it must be refitted or built again.
+     * 
+     * @param offset0 - The offset of the object at time t0.
+     * @param offset1 - The offset of the object at time t1.
+     */
+    void MovingTranslation::setOffsets(const Vec3 &offset0, const Vec3 &offset1){
+        this->offset0 = offset0;
+        this->offset1 = offset1;
+    }
+
+    /**
+     * @brief Computes the intersection between the emitted ray and the moving object.
+     * 
+     * @param ray - The ray.
+     * @param tmin - The min t to consider.
+     * @param tmax - The max t to consider.
+     * @return Hitable::hit_record - The record that stores hit info.
+     */
+    Hitable::hit_record MovingTranslation::intersection(const Ray &ray, const float tmin, const float tmax) const{
+        // Move the ray with the offset at the ray time, then compute intersection.
+        const Vec3 offset = this->getOffsetAt(ray.getTime());
+        Ray movedRay{ray.getOrigin() - offset, ray.getDirection(), ray.getTime()};
+        auto record = this->object->intersection(movedRay, tmin, tmax);
+        
+        // If a point has been hit, translate it.
+        if(record.hit)
+            record.point += offset;
+
+        return record;
+    }
+
+    /**
+     * @brief Returns the axis aligned bounded box that contains the object from t0 to t1. 
+     *        If t0 is equal to t1, the box of the object at that instant is returned.
+     * 
+     * @param t0 - The first instant of time to consider.
+     * @param t1 - The last instant of time to consider.
+     * @return std::unique_ptr<geometry::AABB> The axis aligned bounded box that surrounds the object.
+     */
+    std::unique_ptr<AABB> MovingTranslation::getAABB(const float t0, const float t1) const{
+        auto bb = this->object->getAABB(t0, t1);
+        if(!bb)     return nullptr;
+
+        const Vec3 offset0 = this->getOffsetAt(t0), offset1 = this->getOffsetAt(t1);
+        AABB box0{bb->getMin() + offset0, bb->getMax() + offset0},
+             box1{bb->getMin() + offset1, bb->getMax() + offset1};
+
+        return std::make_unique<AABB>(box0.surroundingBox(box1)); 
+    }
+
+    /**
+     * @brief Get the Material of the moving object.
+     * 
+     * @return const Material& - The material of the moving object.
+     */
+    const std::shared_ptr<materials::Material>& MovingTranslation::getMaterial() const{
+        return this->object->getMaterial();
+    }
+
+    /**
+     * @brief Adds the materials of the moving object to the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void MovingTranslation::bindMaterials(materials::MaterialTable &table){
+        this->object->bindMaterials(table);
+    }
+
+    /**
+     * @brief Get the Texture Coords of the moving object in a given point. Since the time of the hit
+     *        is not known, the offset at t0 is used.
+     * 
+     * @param p - The hit point on the moving object.
+     * @param index - The index of the part hit.
+     * @return srt::geometry::Vec3 - The texture coords. 
+     */
+    Vec3 MovingTranslation::getTextureCoords(const Vec3 &p, const uint32_t index) const{
+        return this->object->getTextureCoords(p - this->offset0, index);
+    }
+
+}
+}
+}
@@ -0,0 +1,51 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MOVING TRANSLATION HEADER FILE                     *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_INSTANCES_MOVINGTRANSLATION_S
+#define S_INSTANCES_MOVINGTRANSLATION_S
+
+// My includes.
+#include "../../Hitable.hpp"
+
+namespace srt{
+namespace geometry{
+namespace instances{
+
+/// This class is used to move the wrapped hitable object linearly in time, from an 
+/// offset at time t0 to another one at time t1.
+class MovingTranslation : public Hitable{
+private:
+    // ATTRIBUTES
+
+    std::shared_ptr<Hitable> object;
+    Vec3 offset0, offset1;
+    float t0, t1;
+
+public:
+    // CONSTRUCTORS
+
+    MovingTranslation(const std::shared_ptr<Hitable> object, const Vec3 &offset0, const Vec3 &offset1, 
+                      const float t0, const float t1);
+
+    // METHODS
+
+    Vec3 getOffsetAt(const float time) const;
+    void setOffsets(const Vec3 &offset0, const Vec3 &offset1);
+    virtual Hitable::hit_record intersection(const srt::Ray &ray, const float tmin, const float tmax) const;
+    virtual const std::shared_ptr<materials::Material> &getMaterial() const;
+    virtual void bindMaterials(materials::MaterialTable &table);
+    virtual std::unique_ptr<geometry::AABB> getAABB(const float t0, const float t1) const;
+    virtual geometry::Vec3 getTextureCoords(const geometry::Vec3 &p, const uint32_t index = 0) const;
+};
+
+}
+}
+}
+
+#endif
@@ -132,14 +132,24 @@ namespace instances{
         return this->object->getMaterial();
     }
 
+    /**
+     * @brief Adds the materials of the rotated object to the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void Rotation::bindMaterials(materials::MaterialTable &table){
+        this->object->bindMaterials(table);
+    }
+
     /**
      * @brief Get the Texture Coords of the rotated object in a given point.
      * 
      * @param p - The hit point on the rotated object.
+     * @param index - The index of the part hit.
      * @return geometry::Vec3 - The texture coords.
      */
-    geometry::Vec3 Rotation::getTextureCoords(const geometry::Vec3 &p) const{
-        return this->object->getTextureCoords(this->rotationMat * p);
+    geometry::Vec3 Rotation::getTextureCoords(const geometry::Vec3 &p, const uint32_t index) const{
+        return this->object->getTextureCoords(this->rotationMat * p, index);
     }
 
 }
@@ -45,8 +45,9 @@ public:
 
     virtual Hitable::hit_record intersection(const srt::Ray &ray, const float tmin, const float tmax) const;
     virtual const std::shared_ptr<materials::Material> &getMaterial() const;
+    virtual void bindMaterials(materials::MaterialTable &table);
     virtual std::unique_ptr<geometry::AABB> getAABB(const float t0, const float t1) const;
-    virtual geometry::Vec3 getTextureCoords(const geometry::Vec3 &p) const;
+    virtual geometry::Vec3 getTextureCoords(const geometry::Vec3 &p, const uint32_t index = 0) const;
 };
 
 }
@@ -29,6 +29,24 @@ namespace instances{
      */
     Translation::Translation(const Translation &old) : object(old.object), offset(old.offset) { }
 
+    /**
+     * @brief Returns the offset of the object.
+     * 
+     * @return const Vec3& - The offset.
+     */
+    const Vec3 &Translation::getOffset() const{
+        return this->offset;
+    }
+
+    /**
+     * @brief Moves the object. The BVH that contains it must be refitted or built again.
+     * 
+     * @param offset - The new offset.
+     */
+    void Translation::setOffset(const Vec3 &offset){
+        this->offset = offset;
+    }
+
     /**
      * @brief Computes the intersection between the emitted ray and the hitable object.
      * 
@@ -71,14 +89,24 @@ namespace instances{
         return this->object->getMaterial();
     }
 
+    /**
+     * @brief Adds the materials of the translated object to the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void Translation::bindMaterials(materials::MaterialTable &table){
+        this->object->bindMaterials(table);
+    }
+
     /**
      * @brief Get the Texture Coords of the tranlsated object in a given point.
      * 
      * @param p - The hit point on the tranlsated object.
+     * @param index - The index of the part hit.
      * @return srt::geometry::Vec3 - The texture coords. 
      */
-    Vec3 Translation::getTextureCoords(const Vec3 &p) const{
-        return this->object->getTextureCoords(p - this->offset);
+    Vec3 Translation::getTextureCoords(const Vec3 &p, const uint32_t index) const{
+        return this->object->getTextureCoords(p - this->offset, index);
     }
 
 }
@@ -9,6 +9,13 @@
  *******************************************************/
 #include "AABox.hpp"
 
+// System includes.
+#include <algorithm>
+#include <limits>
+
+// My includes.
+#include "../../utility/TraversalStats.hpp"
+
 using namespace std;
 using namespace srt::geometry;
 
@@ -16,6 +23,9 @@ namespace srt{
 namespace geometry{
 namespace shapes{
 
+    // The outward normals of the faces.
+    static const array<Vec3, 6> NORMALS = {{{0, 0, 1}, {0, 0, -1}, {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}}};
+
     /**
      * @brief Construct a new AABox::AABox object.
      * 
@@ -24,36 +34,46 @@ namespace shapes{
      * @param material - The material of the box.
      */
     AABox::AABox(const Vec3 &min, const Vec3 &max, const std::shared_ptr<materials::Material> material) :
-        sides {{AARectangle(AARectangle::XY, min.x(), max.x(), min.y(), max.y(), max.z(), material),
-                 AARectangle(AARectangle::XY, min.x(), max.x(), min.y(), max.y(), min.z(), material, true),
-                 AARectangle(AARectangle::XZ, min.x(), max.x(), min.z(), max.z(), max.y(), material),
-                 AARectangle(AARectangle::XZ, min.x(), max.x(), min.z(), max.z(), min.y(), material, true),
-                 AARectangle(AARectangle::YZ, min.y(), max.y(), min.z(), max.z(), max.x(), material),
-                 AARectangle(AARectangle::YZ, min.y(), max.y(), min.z(), max.z(), min.x(), material, true)}}, 
-        min(min), max(max) { }
+        min(min), max(max), material(material), materialId(materials::MaterialTable::NO_MATERIAL_ID) { }
 
     /**
-     * @brief Computes the intersection between the emitted ray and the box.
+     * @brief Computes the intersection between the emitted ray and the box. The ray enters the box 
+     *        at the farthest of the three near planes, through the face of that axis, and exits at the
+     *        nearest of the far planes. If the ray starts inside the box, the exit face is returned.
      * 
      * @param ray - The ray.
      * @param tmin - The min t to consider.
      * @param tmax - The max t to consider.
-     * @return Hitable::hit_record - The record that stores hit info.
+     * @return Hitable::hit_record - The record that stores hit info, the index is the Face hit.
      */
     Hitable::hit_record AABox::intersection(const srt::Ray &ray, const float tmin, const float tmax) const{
-        Hitable::hit_record bestRecord = {false, tmax, nullptr, {}, {}};
-
-        // Check which side is hit.
-        for(const auto &side : sides){
-            Hitable::hit_record currRecord = side.intersection(ray, tmin, bestRecord.t);
-            if(currRecord.hit){
-                bestRecord = currRecord;
-            }
+        SRT_COUNT_PRIMITIVES(1);
+        const Vec3 &o = ray.getOrigin(), &inv = ray.getInvDirection();
+        const uint8_t *sign = ray.getSign();
+        const Vec3 *bounds[2] = {&this->min, &this->max};
+        float tnear = -numeric_limits<float>::infinity(), tfar = numeric_limits<float>::infinity();
+        int nearAxis = 0, farAxis = 0;
+
+        for(int axis = 0; axis < 3; ++axis){
+            const float tEnter = ((*bounds[sign[axis]])[axis] - o[axis]) * inv[axis],
+                        tExit = ((*bounds[1 - sign[axis]])[axis] - o[axis]) * inv[axis];
+            if(tEnter > tnear){ tnear = tEnter; nearAxis = axis; }
+            if(tExit < tfar){   tfar = tExit;   farAxis = axis; }
         }
-            
-        return bestRecord;
-    }
 
+        if(tnear > tfar)    return Hitable::NO_HIT;
+
+        const bool inside = tnear < tmin;
+        const float t = inside ? tfar : tnear;
+        if(t < tmin || t > tmax)    return Hitable::NO_HIT;
+
+        // The faces are sorted from z to x, the face on the max plane first.
+        const int axis = inside ? farAxis : nearAxis;
+        const bool onMin = inside ? sign[axis] : !sign[axis];
+        const uint32_t face = (2 - axis) * 2 + onMin;
+
+        return {true, t, this, ray.getPoint(t), NORMALS[face], this->materialId, face};
+    }
     /**
      * @brief Returns the axis aligned bounded box boxes.
      * 
@@ -66,28 +86,68 @@ namespace shapes{
     }
 
     /**
-     * @brief Gets the Texture Coords of the box in a given point.
+     * @brief Returns the material of the box.
+     * 
+     * @return const Material& - The material of the box.
+     */
+    const std::shared_ptr<materials::Material>& AABox::getMaterial() const{
+        return this->material;
+    }
+
+    /**
+     * @brief Interns the material of the box in the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void AABox::bindMaterials(materials::MaterialTable &table){
+        this->materialId = table.intern(this->material);
+    }
+
+    /**
+     * @brief Gets the Texture Coords of the box in a given point. The coords span the whole face.
      * 
      * @param p - The point hit on the box.
-     * @return geometry::Vec3 - The texture coords.
+     * @param index - The Face hit.
+     * @return geometry::Vec3 - The texture coords in x and y, the texture scale in z.
      */
-    Vec3 AABox::getTextureCoords(const Vec3 &p) const{
-        return p.z() == max.z() ? sides[0].getTextureCoords(p) :
-               p.z() == min.z() ? sides[1].getTextureCoords(p) :
-               p.y() == max.y() ? sides[2].getTextureCoords(p) :
-               p.y() == min.y() ? sides[3].getTextureCoords(p) :
-               p.x() == max.x() ? sides[4].getTextureCoords(p) :
-               sides[5].getTextureCoords(p) ;
+    Vec3 AABox::getTextureCoords(const Vec3 &p, const uint32_t index) const{
+        const Vec3 size = this->max - this->min, local = p - this->min;
+
+        switch(index / 2){
+            case 0:     // XY faces.
+                return {local.x() / size.x(), local.y() / size.y(), std::max(1 / size.x(), 1 / size.y())};
+            case 1:     // XZ faces.
+                return {local.x() / size.x(), local.z() / size.z(), std::max(1 / size.x(), 1 / size.z())};
+            default:    // YZ faces.
+                return {local.y() / size.y(), local.z() / size.z(), std::max(1 / size.y(), 1 / size.z())};
+        }
     }
 
     /**
-     * @brief Returns a face of the box.
+     * @brief Returns the outward normal of a face.
+     * 
+     * @param face - The face.
+     * @return const Vec3& - The normal.
+     */
+    const Vec3 &AABox::getNormal(Face face){
+        return NORMALS[face];
+    }
+
+    /**
+     * @brief Returns a face of the box as a rectangle.
      * 
      * @param face - The face to return.
-     * @return const AARectangle& - The desired face.
+     * @return AARectangle - The desired face.
      */
-    const AARectangle& AABox::getFace(Face face){
-        return this->sides[face];
+    AARectangle AABox::getFace(Face face) const{
+        switch(face){
+            case BACK_FACE:     return AARectangle(AARectangle::XY, min.x(), max.x(), min.y(), max.y(), max.z(), material);
+            case FRONT_FACE:    return AARectangle(AARectangle::XY, min.x(), max.x(), min.y(), max.y(), min.z(), material, true);
+            case UP_FACE:       return AARectangle(AARectangle::XZ, min.x(), max.x(), min.z(), max.z(), max.y(), material);
+            case BOT_FACE:      return AARectangle(AARectangle::XZ, min.x(), max.x(), min.z(), max.z(), min.y(), material, true);
+            case RIGHT_FACE:    return AARectangle(AARectangle::YZ, min.y(), max.y(), min.z(), max.z(), max.x(), material);
+            default:            return AARectangle(AARectangle::YZ, min.y(), max.y(), min.z(), max.z(), min.x(), material, true);
+        }
     }
 }
 }
@@ -20,7 +20,8 @@ namespace srt{
 namespace geometry{
 namespace shapes{
 
-/// This class represents an axis aligned box.
+/// This class represents an axis aligned box. It is intersected with a single slab test, that also
+/// tells the face hit: the face is returned as index of the hit record.
 class AABox : public Hitable{
 public:
     // ENUMERATIONS
@@ -32,8 +33,9 @@ public:
 private:
     // ATTRIBUTES
 
-    std::array<AARectangle, 6> sides;
     Vec3 min, max;
+    std::shared_ptr<materials::Material> material;
+    uint32_t materialId;
 
 public:
     // CONSTRUCTORS
@@ -44,8 +46,11 @@ public:
 
     virtual Hitable::hit_record intersection(const srt::Ray &ray, const float tmin, const float tmax) const;
     virtual std::unique_ptr<AABB> getAABB(const float t0, const float t1) const;
-    virtual Vec3 getTextureCoords(const Vec3 &p) const;
-    const AARectangle &getFace(Face face);
+    virtual const std::shared_ptr<materials::Material> &getMaterial() const;
+    virtual void bindMaterials(materials::MaterialTable &table);
+    virtual Vec3 getTextureCoords(const Vec3 &p, const uint32_t index = 0) const;
+    static const Vec3 &getNormal(Face face);
+    AARectangle getFace(Face face) const;
 };
 
 }
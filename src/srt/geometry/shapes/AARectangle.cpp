@@ -9,6 +9,9 @@
  *******************************************************/
 #include "AARectangle.hpp"
 
+// My includes.
+#include "../../utility/TraversalStats.hpp"
+
 using namespace std;
 using namespace srt::geometry;
 
@@ -29,7 +32,7 @@ namespace shapes{
      */
     AARectangle::AARectangle(const AARectangle::Type type, const float a0_0, const float a0_1, const float a1_0, const float a1_1, 
         const float k, const std::shared_ptr<materials::Material> material, bool flipNormal) :
-        type(type), axis0_0(a0_0), axis0_1(a0_1), axis1_0(a1_0), axis1_1(a1_1), k(k), material(material), isNormalFlipped(flipNormal){ }
+        type(type), axis0_0(a0_0), axis0_1(a0_1), axis1_0(a1_0), axis1_1(a1_1), k(k), material(material), materialId(materials::MaterialTable::NO_MATERIAL_ID), isNormalFlipped(flipNormal){ }
 
     /**
      * @brief Return the normal of the rectangle.
@@ -54,6 +57,7 @@ namespace shapes{
      * @return Hitable::hit_record - The record that stores hit info.
      */
     Hitable::hit_record AARectangle::intersection(const srt::Ray &ray, const float tmin, const float tmax) const{
+        SRT_COUNT_PRIMITIVES(1);
         uint8_t a0, a1, a2;
         const Vec3 ro = ray.getOrigin(), rd = ray.getDirection();
 
@@ -80,7 +84,7 @@ namespace shapes{
             hitPoint[a1] < this->axis1_0 || hitPoint[a1] > this->axis1_1)
             return Hitable::NO_HIT;
         
-        return {true, t, this, hitPoint, this->getNormal(hitPoint)};
+        return {true, t, this, hitPoint, this->getNormal(hitPoint), this->materialId};
     }
 
     /**
@@ -92,6 +96,24 @@ namespace shapes{
         return this->material;
     }
 
+    /**
+     * @brief Interns the material of the rectangle in the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void AARectangle::bindMaterials(materials::MaterialTable &table){
+        this->materialId = table.intern(this->material);
+    }
+
+    /**
+     * @brief Returns the id of the material in the table of the scene.
+     * 
+     * @return uint32_t - The id, MaterialTable::NO_MATERIAL_ID if the material has not been bound yet.
+     */
+    uint32_t AARectangle::getMaterialId() const{
+        return this->materialId;
+    }
+
     /**
      * @brief Returns the axis aligned bounded box boxes.
      * 
@@ -117,22 +139,25 @@ namespace shapes{
      * @brief Get the Texture Coords of the rectangle in a given point.
      * 
      * @param p - The point on the rectangle hit.
-     * @return geometry::Vec3 - The texture coords.
+     * @param index - Unused, a rectangle has only one part.
+     * @return geometry::Vec3 - The texture coords in x and y, the texture scale in z.
      */
-    geometry::Vec3 AARectangle::getTextureCoords(const geometry::Vec3 &p) const{
+    geometry::Vec3 AARectangle::getTextureCoords(const geometry::Vec3 &p, const uint32_t index) const{
+        const float scale = max(1 / (this->axis0_1 - this->axis0_0), 1 / (this->axis1_1 - this->axis1_0));
+
         switch(this->type){
             case AARectangle::XY: 
                 return {(p.x() - this->axis0_0) / (this->axis0_1 - this->axis0_0),
                         (p.y() - this->axis1_0) / (this->axis1_1 - this->axis1_0), 
-                        0};
+                        scale};
             case AARectangle::XZ: 
                 return {(p.x() - this->axis0_0) / (this->axis0_1 - this->axis0_0),
                         (p.z() - this->axis1_0) / (this->axis1_1 - this->axis1_0), 
-                        0};
+                        scale};
             case AARectangle::YZ: 
                 return {(p.y() - this->axis0_0) / (this->axis0_1 - this->axis0_0),
                         (p.z() - this->axis1_0) / (this->axis1_1 - this->axis1_0), 
-                        0};
+                        scale};
         }
     }
 
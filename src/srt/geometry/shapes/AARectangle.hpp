@@ -31,6 +31,7 @@ private:
     Type type;
     float axis0_0, axis0_1, axis1_0, axis1_1, k;
     std::shared_ptr<materials::Material> material;
+    uint32_t materialId;
     bool isNormalFlipped;
 
 public:
@@ -44,8 +45,10 @@ public:
     virtual Vec3 getNormal(const Vec3 &pos) const;
     virtual Hitable::hit_record intersection(const Ray &ray, const float tmin, const float tmax) const;
     virtual const std::shared_ptr<materials::Material> &getMaterial() const;
+    virtual void bindMaterials(materials::MaterialTable &table);
+    uint32_t getMaterialId() const;
     virtual std::unique_ptr<AABB> getAABB(const float t0, const float t1) const;
-    virtual Vec3 getTextureCoords(const Vec3 &p) const;
+    virtual Vec3 getTextureCoords(const Vec3 &p, const uint32_t index = 0) const;
 };
 
 }
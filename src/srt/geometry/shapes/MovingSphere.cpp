@@ -12,6 +12,9 @@
 // System includes.
 #include <cmath>
 
+// My includes.
+#include "../../utility/TraversalStats.hpp"
+
 using namespace std;
 using namespace srt::geometry;
 using namespace srt::materials;
@@ -32,6 +35,16 @@ namespace shapes{
         const float ray, const shared_ptr<Material> material) : Sphere({0, 0, 0}, ray, material),
         c0(c0), c1(c1), t0(t0), t1(t1){ }
 
+    /**
+     * @brief Returns the center of the sphere at a given time. The sphere moves linearly from c0 to c1.
+     * 
+     * @param time - The time instant.
+     * @return Vec3 - The center of the sphere at that time.
+     */
+    Vec3 MovingSphere::getCenterAt(const float time) const{
+        return this->c0 + ((time - this->t0) / (this->t1 - this->t0)) * (this->c1 - this->c0);
+    }
+
     /**
      * @brief Returns the distance t in which a ray eventually intersect the sphere. 
      *        If the ray does not intersect the sphere, it returns -1
@@ -42,7 +55,8 @@ namespace shapes{
      * @return float - The distance from the ray origin, -1 if there is no intersection.
      */
     Hitable::hit_record MovingSphere::intersection(const Ray &ray, const float tmin, const float tmax) const{
-        Vec3 currCenter = this->c0 + ((ray.getTime() - this->t0) / (this->t1 - this->t0)) * (this->c1 - this->c0);
+        SRT_COUNT_PRIMITIVES(1);
+        Vec3 currCenter = this->getCenterAt(ray.getTime());
         float currRay = this->getRay();
         const Vec3 dist = ray.getOrigin() - currCenter;
         const float a = ray.getDirection() ^ 2;
@@ -60,21 +74,23 @@ namespace shapes{
             else                        t = max(t0, t1);
         }
 
-        if(t >= tmin && t <= tmax)  return {true, t, this, ray.getPoint(t), this->getNormal(ray.getPoint(t))};
+        // The normal must be computed with respect to the center at the ray time.
+        if(t >= tmin && t <= tmax)  return {true, t, this, ray.getPoint(t), (ray.getPoint(t) - currCenter) / currRay, this->getMaterialId()};
         return Hitable::NO_HIT; 
     }
 
     /**
      * @brief Returns the box that contains all the space that the sphere cover from t0 to t1.
+     *        If t0 is equal to t1, the box of the sphere at that instant is returned.
      * 
      * @param t0 - The first time instant.
      * @param t1 - The last time instant.
      * @return std::unique_ptr<geometry::AABB> - The AABB.
      */
     std::unique_ptr<geometry::AABB> MovingSphere::getAABB(const float t0, const float t1) const{
-        const Vec3 radVec{this->getRay()};
-        AABB aabb0{this->c0 - radVec, this->c0 + radVec}, 
-             aabb1{this->c1 - radVec, this->c1 + radVec};
+        const Vec3 radVec{this->getRay()}, center0 = this->getCenterAt(t0), center1 = this->getCenterAt(t1);
+        AABB aabb0{center0 - radVec, center0 + radVec}, 
+             aabb1{center1 - radVec, center1 + radVec};
 
         return make_unique<AABB>(aabb0.surroundingBox(aabb1));
     }
@@ -38,6 +38,7 @@ public:
 
     // METHODS 
 
+    srt::geometry::Vec3 getCenterAt(const float time) const;
     virtual Hitable::hit_record intersection(const srt::Ray &ray, const float tmin, const float tmax) const;
     virtual std::unique_ptr<geometry::AABB> getAABB(const float t0, const float t1) const;
 };
@@ -14,6 +14,9 @@
 // System includes.
 #include <cmath>
 
+// My includes.
+#include "../../utility/TraversalStats.hpp"
+
 using namespace std;
 using namespace srt::geometry;
 using namespace srt::materials;
@@ -31,7 +34,7 @@ namespace shapes{
      * @param color - The color of the sphere.
      */
     Sphere::Sphere(const Vec3 &center, const float radius, const shared_ptr<Material> material) : 
-        center(center), radius(radius), material(material) { }
+        center(center), radius(radius), material(material), materialId(MaterialTable::NO_MATERIAL_ID) { }
     
     /**
      * @brief Sphere equality.
@@ -81,6 +84,7 @@ namespace shapes{
      * @return float - The distance from the ray origin, -1 if there is no intersection.
      */
     Hitable::hit_record Sphere::intersection(const Ray &ray, const float tmin, const float tmax) const{
+        SRT_COUNT_PRIMITIVES(1);
         const Vec3 dist = ray.getOrigin() - this->center;
         const float a = ray.getDirection() ^ 2;
         const float b = 2. * (ray.getDirection() * dist);
@@ -97,7 +101,7 @@ namespace shapes{
             else                        t = max(t0, t1);
         }
 
-        if(t >= tmin && t <= tmax)  return {true, t, this, ray.getPoint(t), this->getNormal(ray.getPoint(t))}; 
+        if(t >= tmin && t <= tmax)  return {true, t, this, ray.getPoint(t), this->getNormal(ray.getPoint(t)), this->materialId}; 
         return Hitable::NO_HIT; 
     }
 
@@ -120,6 +124,24 @@ namespace shapes{
         return this->material;
     }
 
+    /**
+     * @brief Interns the material of the sphere in the table of the scene.
+     * 
+     * @param table - The table of the materials.
+     */
+    void Sphere::bindMaterials(materials::MaterialTable &table){
+        this->materialId = table.intern(this->material);
+    }
+
+    /**
+     * @brief Returns the id of the material in the table of the scene.
+     * 
+     * @return uint32_t - The id, MaterialTable::NO_MATERIAL_ID if the material has not been bound yet.
+     */
+    uint32_t Sphere::getMaterialId() const{
+        return this->materialId;
+    }
+
     /**
      * @brief Returns the surrounding axis aligned bounding box. 
      * 
@@ -134,16 +156,18 @@ namespace shapes{
      * @brief Returns the u/v coords of a texture sphere in a given point.
      * 
      * @param p - The point hit in the sphere.
-     * @return geometry::Vec3 - The vector in which x = u, y = v and z = 0.
+     * @param index - Unused, a sphere has only one part.
+     * @return geometry::Vec3 - The vector in which x = u, y = v and z = the texture scale.
      */
-    Vec3 Sphere::getTextureCoords(const Vec3 &p) const{
+    Vec3 Sphere::getTextureCoords(const Vec3 &p, const uint32_t index) const{
         // Compute the phi and theta angle.
         float phi = atan2(p.z(), p.x()), theta = asin(p.y());
         // Compute the u and v coords.
         float u = 1 - (phi + M_PI) / (2 * M_PI),
               v = (theta + M_PI / 2) / M_PI;
 
-        return{u, v, 0};
+        // Half of the circumference covers the whole v range.
+        return{u, v, static_cast<float>(1 / (M_PI * this->radius))};
     }
 }
 }
@@ -0,0 +1,265 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SPHERE SET CLASS FILE                              *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "../src/srt/srt.h"
+
+#include "SphereSet.hpp"
+
+// System includes.
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+// My includes.
+#include "../../utility/TraversalStats.hpp"
+
+using namespace std;
+using namespace srt::geometry;
+using namespace srt::materials;
+
+namespace srt{
+namespace geometry{
+namespace shapes{
+
+    /**
+     * @brief Creates a new empty set.
+     *
+     */
+    SphereSet::SphereSet() { }
+
+    /**
+     * @brief Adds a sphere to the set.
+     *
+     * @param center - The center of the sphere.
+     * @param radius - The radius of the sphere.
+     * @param material - The material of the sphere.
+     */
+    void SphereSet::add(const Vec3 &center, const float radius, const shared_ptr<Material> &material){
+        // Index the palette again if it has been filled by addFrom.
+        if(this->paletteIndex.size() != this->palette.size())
+            for(size_t i = 0; i < this->palette.size(); ++i)
+                this->paletteIndex.emplace(this->palette[i].get(), i);
+
+        const auto it = this->paletteIndex.emplace(material.get(), this->palette.size()).first;
+        if(it->second == this->palette.size()){
+            this->palette.push_back(material);
+            this->materialIds.push_back(MaterialTable::NO_MATERIAL_ID);
+        }
+        this->push(center, radius, it->second);
+    }
+
+    /**
+     * @brief Adds a sphere of another set, looking for its material in the palette without indexing it,
+     *        since the sets made by split() have few materials.
+     *
+     * @param set - The other set.
+     * @param i - The index of the sphere in the other set.
+     */
+    void SphereSet::addFrom(const SphereSet &set, const size_t i){
+        const shared_ptr<Material> &material = set.palette[set.paletteIds[i]];
+        auto it = find(this->palette.begin(), this->palette.end(), material);
+        if(it == this->palette.end()){
+            this->palette.push_back(material);
+            this->materialIds.push_back(MaterialTable::NO_MATERIAL_ID);
+            it = this->palette.end() - 1;
+        }
+        this->push(set.getCenter(i), set.radii[i], it - this->palette.begin());
+    }
+
+    /**
+     * @brief Appends a sphere to the arrays.
+     *
+     * @param center - The center of the sphere.
+     * @param radius - The radius of the sphere.
+     * @param paletteId - The index of its material in the palette.
+     */
+    void SphereSet::push(const Vec3 &center, const float radius, const uint32_t paletteId){
+        this->cx.push_back(center.x());
+        this->cy.push_back(center.y());
+        this->cz.push_back(center.z());
+        this->radii.push_back(radius);
+        this->paletteIds.push_back(paletteId);
+    }
+
+    /**
+     * @brief Returns the number of spheres in the set.
+     *
+     * @return size_t - The number of spheres.
+     */
+    size_t SphereSet::size() const{
+        return this->radii.size();
+    }
+
+    /**
+     * @brief Returns the center of a sphere.
+     *
+     * @param i - The index of the sphere.
+     * @return Vec3 - The center.
+     */
+    Vec3 SphereSet::getCenter(const size_t i) const{
+        return {this->cx[i], this->cy[i], this->cz[i]};
+    }
+
+    /**
+     * @brief Returns the radius of a sphere.
+     *
+     * @param i - The index of the sphere.
+     * @return float - The radius.
+     */
+    float SphereSet::getRadius(const size_t i) const{
+        return this->radii[i];
+    }
+
+    /**
+     * @brief Splits the set in small sets of near spheres, dividing it recursively at the median of
+     *        the centers along the widest axis.
+     *
+     * @param leafSize - The maximum number of spheres in a set.
+     * @return std::vector<std::shared_ptr<Hitable>> - The sets, ready to be the leaves of a BVH.
+     */
+    vector<shared_ptr<Hitable>> SphereSet::split(const size_t leafSize) const{
+        vector<shared_ptr<Hitable>> leaves;
+        vector<size_t> indices(this->size());
+        iota(indices.begin(), indices.end(), 0);
+
+        function<void(size_t, size_t)> divide = [&](const size_t start, const size_t end){
+            if(end - start <= max<size_t>(leafSize, 1)){
+                auto leaf = make_shared<SphereSet>();
+                for(size_t i = start; i < end; ++i)
+                    leaf->addFrom(*this, indices[i]);
+                leaves.push_back(leaf);
+                return;
+            }
+
+            Vec3 lower{numeric_limits<float>::max()}, upper{-numeric_limits<float>::max()};
+            for(size_t i = start; i < end; ++i){
+                const Vec3 c = this->getCenter(indices[i]);
+                lower = {min(lower.x(), c.x()), min(lower.y(), c.y()), min(lower.z(), c.z())};
+                upper = {max(upper.x(), c.x()), max(upper.y(), c.y()), max(upper.z(), c.z())};
+            }
+            const Vec3 extent = upper - lower;
+            const int axis = extent.x() > extent.y() ? (extent.x() > extent.z() ? 0 : 2) : (extent.y() > extent.z() ? 1 : 2);
+
+            const size_t middle = start + (end - start) / 2;
+            nth_element(indices.begin() + start, indices.begin() + middle, indices.begin() + end, [&](size_t a, size_t b){
+                return this->getCenter(a)[axis] < this->getCenter(b)[axis];
+            });
+            divide(start, middle);
+            divide(middle, end);
+        };
+
+        if(this->size() > 0)
+            divide(0, this->size());
+        return leaves;
+    }
+
+    /**
+     * @brief Returns the nearest intersection between a ray and the spheres of the set. The spheres are
+     *        tested LEAF_SIZE at a time by a loop without branches, then the nearest one is chosen.
+     *
+     * @param ray - The ray.
+     * @param tmin - The lower t to consider.
+     * @param tmax - The greater t to consider.
+     * @return Hitable::hit_record - The record, whose index is the index of the sphere hit.
+     */
+    Hitable::hit_record SphereSet::intersection(const Ray &ray, const float tmin, const float tmax) const{
+        const Vec3 &o = ray.getOrigin(), &d = ray.getDirection();
+        const float ox = o.x(), oy = o.y(), oz = o.z(), dx = d.x(), dy = d.y(), dz = d.z();
+        const float a = dx * dx + dy * dy + dz * dz, invA = 1 / a;
+        const float *cx = this->cx.data(), *cy = this->cy.data(), *cz = this->cz.data(), *radii = this->radii.data();
+        const size_t n = this->size();
+        float best = tmax;
+        SRT_COUNT_PRIMITIVES(n);
+        size_t nearest = n;
+
+        for(size_t start = 0; start < n; start += LEAF_SIZE){
+            const size_t count = min(LEAF_SIZE, n - start);
+            float t[LEAF_SIZE];
+
+            // Every lane computes both the roots and keeps the nearest one after tmin, or infinity if none.
+            for(size_t l = 0; l < count; ++l){
+                const size_t i = start + l;
+                const float px = ox - cx[i], py = oy - cy[i], pz = oz - cz[i];
+                const float b = dx * px + dy * py + dz * pz;
+                const float c = px * px + py * py + pz * pz - radii[i] * radii[i];
+                const float delta = b * b - a * c;
+                const float root = sqrt(max(delta, 0.f));
+                const float t0 = (-b - root) * invA, t1 = (-b + root) * invA;
+                const float tt = t0 >= tmin ? t0 : t1;
+                t[l] = delta > 0 && tt >= tmin ? tt : numeric_limits<float>::infinity();
+            }
+
+            // Strictly nearer than the best so far, so that a lane without a hit is never taken, even if tmax is infinite.
+            for(size_t l = 0; l < count; ++l){
+                if(t[l] < best){
+                    best = t[l];
+                    nearest = start + l;
+                }
+            }
+        }
+
+        if(nearest == n)    return Hitable::NO_HIT;
+
+        const Vec3 point = ray.getPoint(best);
+        return {true, best, this, point, (point - this->getCenter(nearest)) / radii[nearest],
+                this->materialIds[this->paletteIds[nearest]], static_cast<uint32_t>(nearest)};
+    }
+
+    /**
+     * @brief Interns the materials of the spheres in the table of the scene.
+     *
+     * @param table - The table of the materials.
+     */
+    void SphereSet::bindMaterials(MaterialTable &table){
+        for(size_t i = 0; i < this->palette.size(); ++i)
+            this->materialIds[i] = table.intern(this->palette[i]);
+    }
+
+    /**
+     * @brief Returns the box surrounding all the spheres.
+     *
+     * @param t0 - The first instant of time to consider (the spheres do not move).
+     * @param t1 - The last instant of time to consider.
+     * @return std::unique_ptr<geometry::AABB> The surrounding axis aligned boundig box.
+     */
+    unique_ptr<AABB> SphereSet::getAABB(const float t0, const float t1) const{
+        if(this->size() == 0)   return make_unique<AABB>();
+
+        Vec3 lower{numeric_limits<float>::max()}, upper{-numeric_limits<float>::max()};
+        for(size_t i = 0; i < this->size(); ++i){
+            lower = {min(lower.x(), cx[i] - radii[i]), min(lower.y(), cy[i] - radii[i]), min(lower.z(), cz[i] - radii[i])};
+            upper = {max(upper.x(), cx[i] + radii[i]), max(upper.y(), cy[i] + radii[i]), max(upper.z(), cz[i] + radii[i])};
+        }
+        return make_unique<AABB>(lower, upper);
+    }
+
+    /**
+     * @brief Returns the u/v coords of a sphere of the set in a given point.
+     *
+     * @param p - The point hit in the sphere.
+     * @param index - The index of the sphere hit.
+     * @return geometry::Vec3 - The vector in which x = u, y = v and z = the texture scale.
+     */
+    Vec3 SphereSet::getTextureCoords(const Vec3 &p, const uint32_t index) const{
+        const Vec3 n = (p - this->getCenter(index)) / this->radii[index];
+        // Compute the phi and theta angle.
+        float phi = atan2(n.z(), n.x()), theta = asin(max(-1.f, min(1.f, n.y())));
+        // Compute the u and v coords.
+        float u = 1 - (phi + M_PI) / (2 * M_PI),
+              v = (theta + M_PI / 2) / M_PI;
+
+        // Half of the circumference covers the whole v range.
+        return{u, v, static_cast<float>(1 / (M_PI * this->radii[index]))};
+    }
+
+}
+}
+}
@@ -0,0 +1,76 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  SPHERE SET HEADER FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_GEOMETRY_SHAPES_SPHERESET_S
+#define S_GEOMETRY_SHAPES_SPHERESET_S
+
+// System includes.
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// My includes.
+#include "../../Hitable.hpp"
+#include "../../materials/Material.hpp"
+
+namespace srt{
+namespace geometry{
+namespace shapes{
+
+/// This class represents a set of static spheres stored as structure of arrays: the centers, the
+/// radii and the materials are kept in separate arrays, so that a ray is intersected with all the
+/// spheres of the set in a single loop that the compiler runs on the SIMD lanes.
+/// A big set should be split in small sets, that become the leaves of the BVH.
+/// The materials are stored once per set, and every sphere keeps only their index: the arrays take
+/// 20 bytes per sphere and the palette 20 bytes per material, so a set whose spheres have all different
+/// materials takes 40 bytes per sphere. While a set is filled, its materials are indexed by a hash map;
+/// the sets made by split() do not keep it.
+class SphereSet : public Hitable{
+public:
+    // CONSTANTS
+
+    static constexpr size_t LEAF_SIZE = 8;
+
+private:
+    // ATTRIBUTES
+
+    std::vector<float> cx, cy, cz, radii;
+    std::vector<uint32_t> paletteIds;
+    std::vector<std::shared_ptr<materials::Material>> palette;
+    std::vector<uint32_t> materialIds;
+    std::unordered_map<const materials::Material*, uint32_t> paletteIndex;
+
+    // METHODS
+
+    void addFrom(const SphereSet &set, const size_t i);
+    void push(const Vec3 &center, const float radius, const uint32_t paletteId);
+
+public:
+    // CONSTRUCTORS
+
+    SphereSet();
+
+    // METHODS
+
+    void add(const Vec3 &center, const float radius, const std::shared_ptr<materials::Material> &material);
+    size_t size() const;
+    Vec3 getCenter(const size_t i) const;
+    float getRadius(const size_t i) const;
+    std::vector<std::shared_ptr<Hitable>> split(const size_t leafSize = LEAF_SIZE) const;
+    virtual Hitable::hit_record intersection(const Ray &ray, const float tmin, const float tmax) const;
+    virtual void bindMaterials(materials::MaterialTable &table);
+    virtual std::unique_ptr<AABB> getAABB(const float t0, const float t1) const;
+    virtual Vec3 getTextureCoords(const Vec3 &p, const uint32_t index = 0) const;
+};
+
+}
+}
+}
+
+#endif
@@ -31,6 +31,24 @@ namespace materials{
     Dielectric::Dielectric(const float refractivity, const Vec3 &attenuation) : 
         refractivity(refractivity), attenuation(attenuation) { }
 
+    /**
+     * @brief Returns the refractive index of the material.
+     * 
+     * @return float - The refractivity.
+     */
+    float Dielectric::getRefractivity() const{
+        return this->refractivity;
+    }
+
+    /**
+     * @brief Returns the fraction of light transmitted.
+     * 
+     * @return const geometry::Vec3& - The attenuation.
+     */
+    const Vec3 &Dielectric::getAttenuation() const{
+        return this->attenuation;
+    }
+
     float Dielectric::schlick(const float cos, const float refractivity) const{
         float r0 = (1 - refractivity) / (1 + refractivity);
         r0 *= r0;
@@ -86,12 +104,12 @@ namespace materials{
 
         if(this->refract(ray.getDirection(), outNormal, refractivity, refracted)){
             if(rand_float() >= this->schlick(cosine, refractivity)){
-                ray = {hitPoint, refracted};
+                ray = {hitPoint, refracted, ray.getTime()};
                 return true;
             }
         }
         
-        ray = {hitPoint, reflected};
+        ray = {hitPoint, reflected, ray.getTime()};
         return true;
     }
 
@@ -34,6 +34,8 @@ public:
     Dielectric(const float refractivity, const geometry::Vec3 &attenuation = {1, 1, 1});
 
     // METHODS
+    float getRefractivity() const;
+    const geometry::Vec3 &getAttenuation() const;
     bool scatter(Ray &ray, geometry::Vec3 &attenuation, const geometry::Vec3 &hitPoint, 
                     const geometry::Vec3 &normal, const geometry::Vec3 &textureCoords = {0, 0, 0}) const;
 };
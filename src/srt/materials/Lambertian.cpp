@@ -25,7 +25,7 @@ namespace materials{
      * 
      * @param albedo - The fraction of light refracted.
      */
-    Lambertian::Lambertian(const std::shared_ptr<Texture> &albedo) : albedo(albedo) { }
+    Lambertian::Lambertian(const std::shared_ptr<Texture> &albedo) : albedo(albedo), albedoProgram(*albedo) { }
 
     /**
      * @brief Returns the quantity of light refracted by the lambertian.
@@ -36,11 +36,20 @@ namespace materials{
         return this->albedo;
     }
 
+    /**
+     * @brief Returns the albedo compiled in a texture program.
+     * 
+     * @return const TextureProgram& - The program of the albedo.
+     */
+    const TextureProgram &Lambertian::getAlbedoProgram() const{
+        return this->albedoProgram;
+    }
+
 
     bool Lambertian::scatter(Ray &ray, Vec3 &attenuation, const Vec3 &hitPoint, const Vec3 &normal, const Vec3 &textureCoords) const{
         Vec3 target = hitPoint + normal + Randomizer::randomInUnitSphere();
         ray = {hitPoint, target - hitPoint, ray.getTime()};
-        attenuation = this->albedo->value(textureCoords.x(), textureCoords.y(), hitPoint);
+        attenuation = this->albedoProgram.evaluate(textureCoords.x(), textureCoords.y(), hitPoint, textureCoords.z());
         return true;
     }
 
@@ -0,0 +1,315 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MATERIAL TABLE CLASS FILE                          *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "MaterialTable.hpp"
+
+// System includes
+#include <cstring>
+#include <functional>
+
+// My other includes
+#include "Lambertian.hpp"
+#include "Metal.hpp"
+#include "Dielectric.hpp"
+#include "lights/DiffuseLight.hpp"
+#include "../textures/StaticTexture.hpp"
+#include "../textures/ImageTexture.hpp"
+
+using namespace srt::geometry;
+using namespace srt::textures;
+
+namespace srt{
+namespace materials{
+
+    /**
+     * @brief Adds a material to the table, if it is not already there.
+     * 
+     * @param material - The material.
+     * @return uint32_t - The id of the material, NO_MATERIAL_ID if the material is null.
+     */
+    uint32_t MaterialTable::add(const std::shared_ptr<Material> &material){
+        if(material == nullptr)     return NO_MATERIAL_ID;
+
+        auto it = this->ids.find(material.get());
+        if(it != this->ids.end())   return it->second;
+
+        Kind kind = OTHER;
+        if(dynamic_cast<const Lambertian*>(material.get()))                 kind = LAMBERTIAN;
+        else if(dynamic_cast<const Metal*>(material.get()))                 kind = METAL;
+        else if(dynamic_cast<const Dielectric*>(material.get()))            kind = DIELECTRIC;
+        else if(dynamic_cast<const lights::DiffuseLight*>(material.get()))  kind = DIFFUSE_LIGHT;
+
+        const uint32_t id = this->entries.size();
+        this->entries.push_back({kind, material.get()});
+        this->owners.push_back(material);
+        this->ids[material.get()] = id;
+        return id;
+    }
+
+    /**
+     * @brief Adds a material to the table, collapsing it in the material already there with the same
+     *        values. The pointer is replaced by the interned instance; the duplicate is kept alive until
+     *        releaseDuplicates(), so that every primitive that shares it finds the same id.
+     *        The Lambertian and DiffuseLight materials are identified by their interned texture, the
+     *        Metal and Dielectric materials by their values, the other materials only by their pointer.
+     * 
+     * @param material - The material, replaced by the interned one.
+     * @return uint32_t - The id of the material, NO_MATERIAL_ID if the material is null.
+     */
+    uint32_t MaterialTable::intern(std::shared_ptr<Material> &material){
+        if(material == nullptr)     return NO_MATERIAL_ID;
+
+        auto it = this->ids.find(material.get());
+        if(it != this->ids.end())   return it->second;
+
+        it = this->duplicateIds.find(material.get());
+        if(it != this->duplicateIds.end()){
+            material = this->owners[it->second];
+            return it->second;
+        }
+
+        // Build the key, and a new instance if the texture of the material has been collapsed.
+        intern_key key{OTHER, {0, 0, 0, 0}, nullptr};
+        std::shared_ptr<Material> interned = material;
+        if(auto lambertian = std::dynamic_pointer_cast<Lambertian>(material)){
+            const std::shared_ptr<Texture> albedo = lambertian->getAlbedo(), texture = this->intern(albedo);
+            key = {LAMBERTIAN, {0, 0, 0, 0}, texture.get()};
+            if(texture != albedo)   interned = std::make_shared<Lambertian>(texture);
+        }
+        else if(auto light = std::dynamic_pointer_cast<lights::DiffuseLight>(material)){
+            const std::shared_ptr<Texture> albedo = light->getAlbedo(), texture = this->intern(albedo);
+            key = {DIFFUSE_LIGHT, {0, 0, 0, 0}, texture.get()};
+            if(texture != albedo)   interned = std::make_shared<lights::DiffuseLight>(texture);
+        }
+        else if(auto metal = dynamic_cast<const Metal*>(material.get())){
+            const Vec3 &albedo = metal->getAlbedo();
+            key = {METAL, {albedo.x(), albedo.y(), albedo.z(), metal->getFuziness()}, nullptr};
+        }
+        else if(auto dielectric = dynamic_cast<const Dielectric*>(material.get())){
+            const Vec3 &attenuation = dielectric->getAttenuation();
+            key = {DIELECTRIC, {dielectric->getRefractivity(), attenuation.x(), attenuation.y(), attenuation.z()}, nullptr};
+        }
+        else
+            return this->add(material);
+
+        // Collapse the material in the one with the same key, or add it.
+        uint32_t id;
+        auto found = this->materialKeys.find(key);
+        if(found != this->materialKeys.end()){
+            id = found->second;
+            ++this->collapsedMaterials;
+            this->bytesSaved += footprint(material.get());
+        }
+        else{
+            // A new instance for a collapsed texture replaces the material: it is still one material met
+            // and one kept, so it is not counted as collapsed.
+            id = this->add(interned);
+            this->materialKeys.emplace(key, id);
+        }
+
+        if(this->owners[id] != material){
+            this->duplicateIds.emplace(material.get(), id);
+            this->duplicates.push_back(material);
+            material = this->owners[id];
+        }
+        return id;
+    }
+
+    /**
+     * @brief Interns a texture: the static textures are identified by their color, the image textures
+     *        by their path, so that an image is decoded once. The other textures are not collapsed.
+     * 
+     * @param texture - The texture.
+     * @return std::shared_ptr<Texture> - The interned texture.
+     */
+    std::shared_ptr<Texture> MaterialTable::intern(const std::shared_ptr<Texture> &texture){
+        std::shared_ptr<Texture> *interned;
+        if(auto color = dynamic_cast<const StaticTexture*>(texture.get())){
+            const Vec3 &c = color->getColor();
+            interned = &this->colorKeys.emplace(intern_key{0, {c.x(), c.y(), c.z(), 0}, nullptr}, texture).first->second;
+        }
+        else if(auto image = dynamic_cast<const ImageTexture*>(texture.get()))
+            interned = &this->imageKeys.emplace(image->getPath(), texture).first->second;
+        else
+            return texture;
+
+        if(*interned != texture && this->duplicateTextures.emplace(texture.get(), texture).second){
+            ++this->collapsedTextures;
+            this->bytesSaved += footprint(texture.get());
+        }
+        return *interned;
+    }
+
+    /**
+     * @brief Frees the duplicates collapsed by intern(), once every primitive has replaced them.
+     * 
+     */
+    void MaterialTable::releaseDuplicates(){
+        this->duplicateIds.clear();
+        this->duplicates.clear();
+        this->duplicateTextures.clear();
+    }
+
+    /**
+     * @brief Returns how many materials and textures have been collapsed by intern().
+     * 
+     * @return interning_stats - The distinct instances met, the ones kept and the estimated bytes saved.
+     */
+    MaterialTable::interning_stats MaterialTable::getInterningStats() const{
+        const size_t uniqueTextures = this->colorKeys.size() + this->imageKeys.size();
+        return {this->entries.size() + this->collapsedMaterials, this->entries.size(), 
+                uniqueTextures + this->collapsedTextures, uniqueTextures, this->bytesSaved};
+    }
+
+    /**
+     * @brief Returns the number of materials in the table.
+     * 
+     * @return size_t - The number of materials.
+     */
+    size_t MaterialTable::size() const{
+        return this->entries.size();
+    }
+
+    /**
+     * @brief Returns the kind of a material.
+     * 
+     * @param id - The id of the material.
+     * @return Kind - The kind.
+     */
+    MaterialTable::Kind MaterialTable::getKind(const uint32_t id) const{
+        return this->entries[id].kind;
+    }
+
+    /**
+     * @brief Returns a material.
+     * 
+     * @param id - The id of the material.
+     * @return const std::shared_ptr<Material>& - The material.
+     */
+    const std::shared_ptr<Material> &MaterialTable::get(const uint32_t id) const{
+        return this->owners[id];
+    }
+
+    /**
+     * @brief Estimates the memory taken by a material, without its texture.
+     * 
+     * @param material - The material.
+     * @return size_t - The bytes of the instance, of its texture program and of their allocations.
+     */
+    size_t MaterialTable::footprint(const Material *material){
+        const TextureProgram *program = nullptr;
+        size_t size = sizeof(Material);
+        if(auto lambertian = dynamic_cast<const Lambertian*>(material)){
+            size = sizeof(Lambertian);
+            program = &lambertian->getAlbedoProgram();
+        }
+        else if(auto light = dynamic_cast<const lights::DiffuseLight*>(material)){
+            size = sizeof(lights::DiffuseLight);
+            program = &light->getAlbedoProgram();
+        }
+        else if(dynamic_cast<const Metal*>(material))       size = sizeof(Metal);
+        else if(dynamic_cast<const Dielectric*>(material))  size = sizeof(Dielectric);
+
+        // The code of the program is allocated apart.
+        if(program != nullptr && program->getCode().capacity() > 0)
+            size += program->getCode().capacity() * sizeof(TextureProgram::instruction) + ALLOCATION_OVERHEAD;
+        return size + ALLOCATION_OVERHEAD;
+    }
+
+    /**
+     * @brief Estimates the memory taken by a texture. An image is counted before it is decoded.
+     * 
+     * @param texture - The texture.
+     * @return size_t - The bytes of the instance and of its allocation.
+     */
+    size_t MaterialTable::footprint(const Texture *texture){
+        if(auto image = dynamic_cast<const ImageTexture*>(texture))
+            return sizeof(ImageTexture) + image->getPath().capacity() + 2 * ALLOCATION_OVERHEAD;
+        if(dynamic_cast<const StaticTexture*>(texture))
+            return sizeof(StaticTexture) + ALLOCATION_OVERHEAD;
+        return sizeof(Texture) + ALLOCATION_OVERHEAD;
+    }
+
+    /**
+     * @brief Hashes the bits of an intern_key.
+     * 
+     * @param key - The key.
+     * @return size_t - The hash.
+     */
+    size_t MaterialTable::intern_hash::operator()(const intern_key &key) const{
+        uint32_t bits[4];
+        std::memcpy(bits, key.values, sizeof(bits));
+        size_t hash = std::hash<const void*>{}(key.pointer) ^ key.tag;
+        for(const uint32_t b : bits)
+            hash = hash * 1099511628211ULL ^ b;
+        return hash;
+    }
+
+    /**
+     * @brief Compares the bits of two intern_keys.
+     * 
+     * @return true - If the keys are the same.
+     */
+    bool MaterialTable::intern_equal::operator()(const intern_key &a, const intern_key &b) const{
+        return a.tag == b.tag && a.pointer == b.pointer && std::memcmp(a.values, b.values, sizeof(a.values)) == 0;
+    }
+
+    /**
+     * @brief Scatters a ray on a material. See Material::scatter.
+     * 
+     * @param id - The id of the material. NO_MATERIAL_ID absorbs the ray.
+     * @return true - If the ray has been scattered.
+     * @return false - If the ray has been absorbed.
+     */
+    bool MaterialTable::scatter(const uint32_t id, Ray &ray, Vec3 &attenuation, const Vec3 &hitPoint, const Vec3 &normal, 
+                                const Vec3 &textureCoords) const{
+        if(id == NO_MATERIAL_ID)    return false;
+
+        // The qualified calls are not dispatched through the virtual table.
+        const entry &e = this->entries[id];
+        switch(e.kind){
+            case LAMBERTIAN:
+                return static_cast<const Lambertian*>(e.material)->Lambertian::scatter(ray, attenuation, hitPoint, normal, textureCoords);
+            case METAL:
+                return static_cast<const Metal*>(e.material)->Metal::scatter(ray, attenuation, hitPoint, normal, textureCoords);
+            case DIELECTRIC:
+                return static_cast<const Dielectric*>(e.material)->Dielectric::scatter(ray, attenuation, hitPoint, normal, textureCoords);
+            case DIFFUSE_LIGHT:
+                return static_cast<const lights::DiffuseLight*>(e.material)->lights::DiffuseLight::scatter(ray, attenuation, hitPoint, 
+                                                                                                          normal, textureCoords);
+            default:
+                return e.material->scatter(ray, attenuation, hitPoint, normal, textureCoords);
+        }
+    }
+
+    /**
+     * @brief Returns the color emitted by a material. See Material::emit.
+     * 
+     * @param id - The id of the material. NO_MATERIAL_ID does not emit.
+     * @return true - If the material is an emitter.
+     * @return false - If the material is not an emitter.
+     */
+    bool MaterialTable::emit(const uint32_t id, const Vec3 &hitPoint, const Vec3 &textureCoords, Vec3 &emittedColor) const{
+        if(id == NO_MATERIAL_ID)    return false;
+
+        const entry &e = this->entries[id];
+        switch(e.kind){
+            case LAMBERTIAN:
+            case METAL:
+            case DIELECTRIC:
+                return false;
+            case DIFFUSE_LIGHT:
+                return static_cast<const lights::DiffuseLight*>(e.material)->lights::DiffuseLight::emit(hitPoint, textureCoords, emittedColor);
+            default:
+                return e.material->emit(hitPoint, textureCoords, emittedColor);
+        }
+    }
+
+}
+}
@@ -0,0 +1,118 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MATERIAL TABLE HEADER FILE                         *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_MATERIALS_MATERIALTABLE_S
+#define S_MATERIALS_MATERIALTABLE_S
+
+// System includes.
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// My includes
+#include "Material.hpp"
+#include "../textures/Texture.hpp"
+
+namespace srt{
+namespace materials{
+
+/// The flat table of the materials of a scene. The primitives refer to their material by its index
+/// in the table, and the table dispatches the calls with a switch on the kind of the material, so
+/// that the common materials are called without virtual calls nor reference counting.
+class MaterialTable{
+public:
+    // CONSTANTS
+
+    static constexpr uint32_t NO_MATERIAL_ID = UINT32_MAX;
+
+    // ENUMERATIONS
+
+    /// The kinds of material known by the table. The others are called through their virtual methods.
+    enum Kind : uint8_t {LAMBERTIAN, METAL, DIELECTRIC, DIFFUSE_LIGHT, OTHER};
+
+    // STRUCTURES
+
+    /// The result of the interning: the distinct instances met and the ones kept.
+    /// The bytes are an estimate of the memory freed by the collapsed instances.
+    typedef struct is{
+        size_t materials, uniqueMaterials, textures, uniqueTextures, bytesSaved;
+    } interning_stats;
+
+private:
+    // CONSTANTS
+
+    /// The estimated bytes added to an instance by its allocation: the reference counts and the
+    /// virtual table of the shared control block, and the header of the allocator.
+    static constexpr size_t ALLOCATION_OVERHEAD = 3 * sizeof(void*);
+
+    // STRUCTURES
+
+    typedef struct en{
+        Kind kind;
+        const Material *material;
+    } entry;
+
+    /// The values that identify a material or a texture. The pointer is the interned texture of a
+    /// material, the values are compared bit by bit.
+    typedef struct ik{
+        uint32_t tag;
+        float values[4];
+        const void *pointer;
+    } intern_key;
+
+    struct intern_hash{
+        size_t operator()(const intern_key &key) const;
+    };
+
+    struct intern_equal{
+        bool operator()(const intern_key &a, const intern_key &b) const;
+    };
+
+    // ATTRIBUTES
+
+    std::vector<entry> entries;
+    std::vector<std::shared_ptr<Material>> owners;
+    std::unordered_map<const Material*, uint32_t> ids;
+
+    std::unordered_map<intern_key, uint32_t, intern_hash, intern_equal> materialKeys;
+    std::unordered_map<intern_key, std::shared_ptr<textures::Texture>, intern_hash, intern_equal> colorKeys;
+    std::unordered_map<std::string, std::shared_ptr<textures::Texture>> imageKeys;
+    std::unordered_map<const Material*, uint32_t> duplicateIds;
+    std::vector<std::shared_ptr<Material>> duplicates;
+    std::unordered_map<const textures::Texture*, std::shared_ptr<textures::Texture>> duplicateTextures;
+    size_t collapsedMaterials = 0, collapsedTextures = 0, bytesSaved = 0;
+
+    // METHODS
+
+    std::shared_ptr<textures::Texture> intern(const std::shared_ptr<textures::Texture> &texture);
+
+    static size_t footprint(const Material *material);
+    static size_t footprint(const textures::Texture *texture);
+
+public:
+    // METHODS
+
+    uint32_t add(const std::shared_ptr<Material> &material);
+    uint32_t intern(std::shared_ptr<Material> &material);
+    void releaseDuplicates();
+    interning_stats getInterningStats() const;
+    size_t size() const;
+    Kind getKind(const uint32_t id) const;
+    const std::shared_ptr<Material> &get(const uint32_t id) const;
+    bool scatter(const uint32_t id, Ray &ray, geometry::Vec3 &attenuation, const geometry::Vec3 &hitPoint, 
+                 const geometry::Vec3 &normal, const geometry::Vec3 &textureCoords) const;
+    bool emit(const uint32_t id, const geometry::Vec3 &hitPoint, const geometry::Vec3 &textureCoords, 
+              geometry::Vec3 &emittedColor) const;
+};
+}
+}
+
+#endif
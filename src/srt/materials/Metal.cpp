@@ -27,6 +27,24 @@ namespace materials{
     Metal::Metal(const geometry::Vec3 &albedo, const float fuziness) : albedo(albedo),
         fuziness(fuziness >= 0 ? fuziness <= 1 ? fuziness : 1 : 0 ) { }
 
+    /**
+     * @brief Returns the fraction of light reflected.
+     * 
+     * @return const geometry::Vec3& - The albedo.
+     */
+    const Vec3 &Metal::getAlbedo() const{
+        return this->albedo;
+    }
+
+    /**
+     * @brief Returns how much the reflected rays are perturbed.
+     * 
+     * @return float - The fuziness, ranged from 0 to 1.
+     */
+    float Metal::getFuziness() const{
+        return this->fuziness;
+    }
+
     /**
      * @brief Returns a vector reflected by given normal.
      * 
@@ -51,7 +69,7 @@ namespace materials{
     bool Metal::scatter(Ray &ray, Vec3 &attenuation, const Vec3 &hitPoint, const Vec3 &normal, const Vec3 &textureCoords) const{
         Vec3 reflected = reflect(ray.getDirection(), normal);
         if(reflected * normal > 0){
-            ray = {hitPoint, reflected + this->fuziness * Randomizer::randomInUnitSphere()};
+            ray = {hitPoint, reflected + this->fuziness * Randomizer::randomInUnitSphere(), ray.getTime()};
             attenuation = this->albedo;
             return true;
         }
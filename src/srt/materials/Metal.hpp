@@ -32,6 +32,8 @@ public:
     Metal(const geometry::Vec3 &albedo, const float fuziness);
 
     // METHODS
+    const geometry::Vec3 &getAlbedo() const;
+    float getFuziness() const;
     bool scatter(Ray &ray, geometry::Vec3 &attenuation, const geometry::Vec3 &hitPoint, 
                     const geometry::Vec3 &normal, const geometry::Vec3 &textureCoords = {0, 0, 0}) const;
 };
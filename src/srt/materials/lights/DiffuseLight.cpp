@@ -18,7 +18,7 @@ namespace lights{
      * 
      * @param albedo - The fraction of light refracted.
      */
-    DiffuseLight::DiffuseLight(const std::shared_ptr<textures::Texture> &albedo) : albedo(albedo) { }
+    DiffuseLight::DiffuseLight(const std::shared_ptr<textures::Texture> &albedo) : albedo(albedo), albedoProgram(*albedo) { }
 
     /**
      * @brief Returns the quantity of light refracted by the lambertian.
@@ -29,6 +29,15 @@ namespace lights{
         return this->albedo;
     }
 
+    /**
+     * @brief Returns the albedo compiled in a texture program.
+     * 
+     * @return const textures::TextureProgram& - The program of the albedo.
+     */
+    const textures::TextureProgram &DiffuseLight::getAlbedoProgram() const{
+        return this->albedoProgram;
+    }
+
     /**
      * @brief 
      * 
@@ -53,7 +62,7 @@ namespace lights{
      * @return false - If the material is not an emitter.
      */
     bool DiffuseLight::emit(const geometry::Vec3 &hitPoint, const geometry::Vec3 &textureCoords, geometry::Vec3 &emittedColor) const{
-        emittedColor = this->albedo->value(textureCoords.x(), textureCoords.y(), hitPoint);
+        emittedColor = this->albedoProgram.evaluate(textureCoords.x(), textureCoords.y(), hitPoint, textureCoords.z());
         return true;
     }
 
@@ -13,6 +13,7 @@
 // My includes
 #include "../Material.hpp"
 #include "../../textures/Texture.hpp"
+#include "../../textures/TextureProgram.hpp"
 
 namespace srt{
 namespace materials{
@@ -24,6 +25,7 @@ private:
     // ATTRIBUTES
 
     std::shared_ptr<textures::Texture> albedo;
+    textures::TextureProgram albedoProgram;
 public:
     //CONSTRUCTORS
 
@@ -31,6 +33,7 @@ public:
 
     // METHODS
     const std::shared_ptr<textures::Texture> getAlbedo();
+    const textures::TextureProgram &getAlbedoProgram() const;
     virtual bool scatter(Ray &ray, geometry::Vec3 &attenuation, const geometry::Vec3 &hitPoint, 
                     const geometry::Vec3 &normal, const geometry::Vec3 &textureCoords) const;
     virtual bool emit(const geometry::Vec3 &hitPoint, const geometry::Vec3 &textureCoords, geometry::Vec3 &emittedColor) const;
@@ -0,0 +1,21 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Basic Ray Tracer                              *
+ *                                                     *
+ *  PATHS                                              *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_PATHS_S
+#define S_PATHS_S
+
+#include <string>
+
+namespace srt{
+    const std::string BASE_DIR = "/root/repo/"; // The base directory.
+    const std::string FILES_DIR = BASE_DIR + "files/"; // The files directory
+}
+
+
+#endif
@@ -9,11 +9,50 @@
  *******************************************************/
 #include "srt.h"
 
+#include <atomic>
+#include <cstdint>
+
+#ifndef _WIN32
+// The state of drand48 given by the last rand_seed, 0 as in glibc before the first.
+std::atomic<uint64_t> seedState{0};
+// Bumped by rand_seed, so that every thread starts its sequence again.
+std::atomic<uint32_t> seedVersion{0};
+// The threads that have started their sequence since the last rand_seed.
+std::atomic<uint32_t> seededThreads{0};
+#endif
+
+// Every thread has its own sequence, so that the threads of a render do not share the state of the generator.
+// The first thread that draws after rand_seed gets the sequence of srand48(seed), the others a sequence of
+// their own, so a render on one thread gives the same numbers as drand48.
 float rand_float()
 {
 #ifdef _WIN32
     return rand() / (RAND_MAX + 1.0);
-#elif
-    return drand48()
+#else
+    thread_local unsigned short state[3];
+    thread_local uint32_t version = UINT32_MAX;
+
+    const uint32_t current = seedVersion.load(std::memory_order_acquire);
+    if(version != current){
+        version = current;
+        const uint64_t thread = seededThreads.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t start = seedState.load(std::memory_order_relaxed) ^ (thread * 0x9E3779B97F4A7C15ull & 0xFFFFFFFF) << 16;
+        state[0] = start & 0xFFFF;
+        state[1] = (start >> 16) & 0xFFFF;
+        state[2] = (start >> 32) & 0xFFFF;
+    }
+    return erand48(state);
+#endif
+}
+
+void rand_seed(const long seed)
+{
+#ifdef _WIN32
+    srand(seed);
+#else
+    // As srand48: the low 32 bits of the seed over 0x330E.
+    seedState.store(static_cast<uint64_t>(static_cast<uint32_t>(seed)) << 16 | 0x330E, std::memory_order_relaxed);
+    seededThreads.store(0, std::memory_order_relaxed);
+    seedVersion.fetch_add(1, std::memory_order_release);
 #endif
-}
\ No newline at end of file
+}
@@ -15,4 +15,5 @@
 #define M_PI 3.1415926535897
 #endif
 
-float rand_float();
\ No newline at end of file
+float rand_float();
+void rand_seed(const long seed);
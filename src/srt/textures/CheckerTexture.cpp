@@ -34,17 +34,35 @@ namespace textures{
     CheckerTexture::CheckerTexture(const std::shared_ptr<Texture> c0, const std::shared_ptr<Texture> c1) : 
         c0(c0), c1(c1) {} 
 
+    /**
+     * @brief Returns the texture of the cells in which the sines product is positive.
+     * 
+     * @return const std::shared_ptr<Texture>& - The first texture.
+     */
+    const std::shared_ptr<Texture> &CheckerTexture::getFirst() const{
+        return this->c0;
+    }
+
+    /**
+     * @brief Returns the texture of the other cells.
+     * 
+     * @return const std::shared_ptr<Texture>& - The second texture.
+     */
+    const std::shared_ptr<Texture> &CheckerTexture::getSecond() const{
+        return this->c1;
+    }
+
     /**
      * @brief Return an RGB value that represents the color of the texture in that point.
      * 
      * @param u - The x texture coord. Ranged from 0 to 1.
      * @param v - The y texture coord. Ranged from 0 to 1.
      * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords.
      * @return geometry::Vec3 - The color of the texture.
      */
-    geometry::Vec3 CheckerTexture::value(const float u, const float v, const geometry::Vec3 &p) const{
-        float sines = sin(10 * p.x()) * sin(10 * p.y()) * sin(10 * p.z());
-        return sines > 0 ? this->c0->value(u, v, p) : this->c1->value(u, v, p);
+    geometry::Vec3 CheckerTexture::value(const float u, const float v, const geometry::Vec3 &p, const float footprint) const{
+        return isFirst(p) ? this->c0->value(u, v, p, footprint) : this->c1->value(u, v, p, footprint);
     }
 
 }
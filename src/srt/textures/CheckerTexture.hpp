@@ -11,6 +11,7 @@
 #define S_TEXTURES_CHECKERTEXTURE_S
 
 // System includes.
+#include <cmath>
 #include <memory>
 
 // My includes.
@@ -19,7 +20,7 @@
 namespace srt{
 namespace textures{
 
-/// This represents a monochromatic texture (basically a color).
+/// This represents a checker of two textures, alternating in the 3D space.
 class CheckerTexture : public Texture{
 private:
     std::shared_ptr<Texture> c0, c1;
@@ -28,7 +29,21 @@ public:
     CheckerTexture();
     CheckerTexture(const std::shared_ptr<Texture> c0, const std::shared_ptr<Texture> c1);
 
-    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p) const;
+    // METHODS
+
+    const std::shared_ptr<Texture> &getFirst() const;
+    const std::shared_ptr<Texture> &getSecond() const;
+    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const;
+
+    /**
+     * @brief Returns whether a point falls in a cell of the first texture.
+     * 
+     * @param p - The point hit on the object.
+     * @return bool - True for the first texture, false for the second one.
+     */
+    static inline bool isFirst(const geometry::Vec3 &p){
+        return std::sin(10 * p.x()) * std::sin(10 * p.y()) * std::sin(10 * p.z()) > 0;
+    }
 };
 
 }
@@ -9,45 +9,161 @@
  *******************************************************/
 #include "ImageTexture.hpp"
 
+// System includes.
+#include <iostream>
+#include <stdexcept>
+
 // Images library.
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+// My other includes.
+#include "../utility/Profiler.hpp"
+#include "../utility/ThreadPool.hpp"
+
 namespace srt{
 namespace textures{
 
+    std::mutex ImageTexture::pendingMutex;
+    std::vector<std::weak_ptr<ImageTexture::content>> ImageTexture::pending;
+
     /**
-     * @brief Constructs a new Image Texture from a given image.
+     * @brief Constructs a new Image Texture from a given image. Only the header of the image is read,
+     *        the pixels are decoded later. A baked image is mapped immediately.
      * 
      * @param imagePath - The path in which find the image.
      */
-    ImageTexture::ImageTexture(const std::string &imagePath){
+    ImageTexture::ImageTexture(const std::string &imagePath) : image(std::make_shared<content>()){
+        int nx, ny, nc;
+
+        this->image->path = imagePath;
+        if(isBaked(imagePath)){
+            std::call_once(this->image->loaded, load, std::ref(*this->image));
+            return;
+        }
+
+        if(!stbi_info(imagePath.c_str(), &nx, &ny, &nc))
+            throw std::invalid_argument("The image " + imagePath + " cannot be loaded");
+
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.push_back(this->image);
+    }
+
+    /**
+     * @brief Returns whether a file contains a baked image, looking at its extension.
+     * 
+     * @param path - The path of the file.
+     * @return bool - True if the file has the BAKED_EXTENSION.
+     */
+    bool ImageTexture::isBaked(const std::string &path){
+        const std::string extension{BAKED_EXTENSION};
+        return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    /**
+     * @brief Decodes an image and builds its mip pyramid, keeping the precision of the file.
+     *        A baked image is mapped in memory instead.
+     * 
+     * @param image - The image to load.
+     */
+    void ImageTexture::load(content &image){
+        utility::Profiler::Zone zone{"texture load"};
+        const char *path = image.path.c_str();
         int nx, ny, nc;
-        unsigned char *rawData = stbi_load(imagePath.c_str(), &nx, &ny, &nc, 0);
-        this->data = {rawData, rawData + (nx * ny * 3)};
-        this->w = nx;
-        this->h = ny;
+
+        if(isBaked(image.path))
+            image.mipmap = std::make_unique<MipMap>(image.path);
+        else if(stbi_is_hdr(path)){
+            float *rawData = stbi_loadf(path, &nx, &ny, &nc, 0);
+            if(rawData == nullptr)
+                throw std::invalid_argument("The image " + image.path + " cannot be loaded");
+            image.mipmap = std::make_unique<MipMap>(rawData, nx, ny, nc, MipMap::FLOAT);
+            stbi_image_free(rawData);
+        }
+        else if(stbi_is_16_bit(path)){
+            stbi_us *rawData = stbi_load_16(path, &nx, &ny, &nc, 0);
+            if(rawData == nullptr)
+                throw std::invalid_argument("The image " + image.path + " cannot be loaded");
+            image.mipmap = std::make_unique<MipMap>(rawData, nx, ny, nc, MipMap::UINT16);
+            stbi_image_free(rawData);
+        }
+        else{
+            stbi_uc *rawData = stbi_load(path, &nx, &ny, &nc, 0);
+            if(rawData == nullptr)
+                throw std::invalid_argument("The image " + image.path + " cannot be loaded");
+            image.mipmap = std::make_unique<MipMap>(rawData, nx, ny, nc, MipMap::UINT8);
+            stbi_image_free(rawData);
+        }
+    }
+
+    /**
+     * @brief Returns the path of the image.
+     * 
+     * @return const std::string& - The path given when the texture was created.
+     */
+    const std::string &ImageTexture::getPath() const{
+        return this->image->path;
     }
 
     /**
      * @brief Returns an RGB value that represents the color of the image in that point.
+     *        The image is loaded here if it has not been loaded yet.
      * 
      * @param u - The x texture coord. Ranged from 0 to 1.
      * @param v - The y texture coord. Ranged from 0 to 1.
      * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords.
      * @return geometry::Vec3 - The color of the image.
      */
-    geometry::Vec3 ImageTexture::value(const float u, const float v, const geometry::Vec3 &p) const{
-        // The u/v coords are computed from bottom-left angle, we have it as upper left angle as origin.
-        int x = u * w, y = (1 - v) * h - 0.0001;
+    geometry::Vec3 ImageTexture::value(const float u, const float v, const geometry::Vec3 &p, const float footprint) const{
+        std::call_once(this->image->loaded, load, std::ref(*this->image));
+        return this->image->mipmap->sample(u, v, footprint);
+    }
 
-        // Be sure that they are in the right range.
-        x = x >= 0 && x <= w ? x : (x < 0 ? 0 : w-1);
-        y = y >= 0 && y <= w ? y : (y < 0 ? 0 : h-1);
+    /**
+     * @brief Loads in parallel all the images not loaded yet, on a pool of background threads.
+     *        If an image cannot be decoded, it is loaded again (and the error thrown) when it is sampled.
+     * 
+     * @param wait - If true, returns only when all the images have been loaded.
+     */
+    void ImageTexture::prefetch(const bool wait){
+        static utility::ThreadPool loaders;
+        std::vector<std::shared_ptr<content>> images;
+
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            for(const auto &weak : pending)
+                if(auto image = weak.lock())
+                    images.push_back(image);
+            pending.clear();
+        }
+
+        for(const auto &image : images){
+            loaders.submit([image](){
+                try{
+                    std::call_once(image->loaded, load, std::ref(*image));
+                }
+                catch(const std::exception &e){
+                    std::cerr << e.what() << std::endl;
+                }
+            });
+        }
+
+        if(wait)
+            loaders.wait();
+    }
 
-        // Return the color in a range from 0 to 1.
-        auto it = data.begin() + (3 * x + 3 * y * w);
-        return {it[0] / 255.f, it[1] / 255.f, it[2] / 255.f};
+    /**
+     * @brief Decodes an image and writes its mip pyramid in a file that can be mapped by the renderer.
+     * 
+     * @param imagePath - The path of the image.
+     * @param bakedPath - The file to write. It should have the BAKED_EXTENSION.
+     */
+    void ImageTexture::bake(const std::string &imagePath, const std::string &bakedPath){
+        content image;
+        image.path = imagePath;
+        load(image);
+        image.mipmap->bake(bakedPath);
     }
 
 }
@@ -11,20 +11,51 @@
 #define S_TEXTURES_IMAGETEXTURE_S
 
 // System includes.
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 // My includes.
 #include "Texture.hpp"
+#include "MipMap.hpp"
 
 namespace srt{
 namespace textures{
 
-/// This represents a monochromatic texture (basically a color).
+/// This represents a texture read from an image. The image is stored as a tiled mip pyramid whose
+/// tiles are paged in through the TileCache, and it is sampled with trilinear filtering.
+/// The image is decoded only when it is sampled for the first time, or in background by prefetch().
+/// 8 bit, 16 bit and HDR images are supported, with 1 to 4 channels.
+/// An image can be baked offline in a file with the BAKED_EXTENSION: that file is just mapped in memory.
 class ImageTexture : public Texture{
+public:
+    // CONSTANTS
+
+    static constexpr const char *BAKED_EXTENSION = ".srtt";
+
 private:
-    std::vector<unsigned char> data;
-    size_t h, w;
+    // STRUCTURES
+
+    /// The image, decoded at most once. It is shared with the loading threads.
+    typedef struct c{
+        std::string path;
+        std::once_flag loaded;
+        std::unique_ptr<MipMap> mipmap;
+    } content;
+
+    // ATTRIBUTES
+
+    std::shared_ptr<content> image;
+
+    static std::mutex pendingMutex;
+    static std::vector<std::weak_ptr<content>> pending;
+
+    // METHODS
+
+    static bool isBaked(const std::string &path);
+    static void load(content &image);
+
 public:
     // CONSTRUCTORS
 
@@ -32,7 +63,11 @@ public:
 
     // METHODS
 
-    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p) const;
+    const std::string &getPath() const;
+    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const;
+
+    static void prefetch(const bool wait = false);
+    static void bake(const std::string &imagePath, const std::string &bakedPath);
 };
 
 }
@@ -0,0 +1,465 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MIPMAP CLASS FILE                                  *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "MipMap.hpp"
+
+// Other system includes.
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// My other includes.
+#include "TileCache.hpp"
+
+using namespace srt::geometry;
+
+namespace srt{
+namespace textures{
+
+    static std::atomic<uint32_t> nextId{0};
+
+    /// The header of a baked mipmap. It is followed by the width and height (as 64 bit integers) of 
+    /// every level, and then by all the tiles, level by level and row by row, starting at an offset 
+    /// multiple of BAKED_ALIGNMENT. The numbers are stored with the byte order of the machine.
+    typedef struct bh{
+        char magic[4];
+        uint32_t version, format, channels, tileSize, levels;
+    } baked_header;
+
+    static const char BAKED_MAGIC[4] = {'S', 'R', 'T', 'T'};
+
+    /**
+     * @brief Returns a component as a float, in a range from 0 to 1 for the integer types.
+     * 
+     */
+    template<typename T> static inline float toFloat(const T c){ 
+        return c / float(std::numeric_limits<T>::max()); 
+    }
+    template<> inline float toFloat<float>(const float c){ 
+        return c; 
+    }
+
+    /**
+     * @brief Returns the average of four components from their sum, rounded for the integer types.
+     * 
+     */
+    template<typename T> static inline T average(const float sum){ 
+        return static_cast<T>(sum / 4 + 0.5f); 
+    }
+    template<> inline float average<float>(const float sum){ 
+        return sum / 4; 
+    }
+
+    /**
+     * @brief Returns the first level of the pyramid, keeping only the used channels of the source image.
+     *
+     * @param data - The pixels of the image.
+     * @param size - The number of pixels of the image.
+     * @param sourceChannels - The channels of the image.
+     * @param channels - The channels to keep.
+     * @return std::vector<unsigned char> - The pixels of the first level.
+     */
+    template<typename T>
+    static std::vector<unsigned char> extract(const void *data, const size_t size, const size_t sourceChannels, const size_t channels){
+        std::vector<unsigned char> result(size * channels * sizeof(T));
+        const T *in = static_cast<const T*>(data);
+        T *out = reinterpret_cast<T*>(result.data());
+
+        for(size_t i = 0; i < size; ++i)
+            for(size_t c = 0; c < channels; ++c)
+                out[i * channels + c] = in[i * sourceChannels + c];
+
+        return result;
+    }
+
+    /**
+     * @brief Returns the image halved in both dimensions, averaging blocks of 2x2 pixels.
+     *
+     * @param data - The pixels of the image.
+     * @param width - The width of the image.
+     * @param height - The height of the image.
+     * @param channels - The channels of the image.
+     * @return std::vector<unsigned char> - The pixels of the halved image.
+     */
+    template<typename T>
+    static std::vector<unsigned char> downsample(const std::vector<unsigned char> &data, const size_t width, const size_t height, 
+                                                 const size_t channels){
+        const size_t newWidth = std::max<size_t>(1, width / 2), newHeight = std::max<size_t>(1, height / 2);
+        std::vector<unsigned char> result(newWidth * newHeight * channels * sizeof(T));
+        const T *in = reinterpret_cast<const T*>(data.data());
+        T *out = reinterpret_cast<T*>(result.data());
+
+        for(size_t y = 0; y < newHeight; ++y){
+            const size_t y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+            for(size_t x = 0; x < newWidth; ++x){
+                const size_t x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+                for(size_t c = 0; c < channels; ++c){
+                    const float sum = float(in[(y0 * width + x0) * channels + c]) + in[(y0 * width + x1) * channels + c] +
+                                      in[(y1 * width + x0) * channels + c] + in[(y1 * width + x1) * channels + c];
+                    out[(y * newWidth + x) * channels + c] = average<T>(sum);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Builds the mip pyramid of an image and writes its tiles in a temporary store.
+     *
+     * @param data - The pixels of the image, row by row from the upper left angle.
+     * @param width - The width of the image.
+     * @param height - The height of the image.
+     * @param sourceChannels - The channels of the image: 1 (gray), 2 (gray, alpha), 3 (rgb) or 4 (rgba).
+     * @param format - The type of the components of the image.
+     */
+    MipMap::MipMap(const void *data, const size_t width, const size_t height, const size_t sourceChannels, const Format format) : 
+        id(nextId++), format(format), channels(sourceChannels >= 3 ? 3 : 1), store(std::tmpfile(), &std::fclose), tilesOffset(0){
+        if(this->store == nullptr)
+            throw std::runtime_error("Cannot create the store for the mipmap tiles");
+        if(sourceChannels < 1 || sourceChannels > 4)
+            throw std::invalid_argument("The image must have from 1 to 4 channels");
+
+        std::vector<unsigned char> curr;
+        size_t w = width, h = height, firstTile = 0;
+
+        switch(format){
+            case UINT8:     curr = extract<uint8_t>(data, width * height, sourceChannels, this->channels); break;
+            case UINT16:    curr = extract<uint16_t>(data, width * height, sourceChannels, this->channels); break;
+            case FLOAT:     curr = extract<float>(data, width * height, sourceChannels, this->channels); break;
+        }
+
+        while(true){
+            level_info lv{w, h, (w + TILE_SIZE - 1) / TILE_SIZE, (h + TILE_SIZE - 1) / TILE_SIZE, firstTile};
+            this->writeLevel(curr, lv);
+            this->levels.push_back(lv);
+            firstTile += lv.tilesX * lv.tilesY;
+
+            if(w == 1 && h == 1)    break;
+
+            switch(format){
+                case UINT8:     curr = downsample<uint8_t>(curr, w, h, this->channels); break;
+                case UINT16:    curr = downsample<uint16_t>(curr, w, h, this->channels); break;
+                case FLOAT:     curr = downsample<float>(curr, w, h, this->channels); break;
+            }
+            w = std::max<size_t>(1, w / 2);
+            h = std::max<size_t>(1, h / 2);
+        }
+    }
+
+    /**
+     * @brief Maps a baked mipmap in memory. The tiles are read on demand by the system.
+     *
+     * @param bakedPath - The file written by bake().
+     */
+    MipMap::MipMap(const std::string &bakedPath) : 
+        id(nextId++), store(nullptr, &std::fclose), mapping(std::make_unique<utility::MappedFile>(bakedPath)){
+        const unsigned char *data = this->mapping->getData();
+        const size_t size = this->mapping->getSize();
+        baked_header header;
+
+        if(size < sizeof(header))
+            throw std::invalid_argument("The file " + bakedPath + " is not a baked texture");
+        std::memcpy(&header, data, sizeof(header));
+        if(std::memcmp(header.magic, BAKED_MAGIC, sizeof(BAKED_MAGIC)) != 0 || header.version != BAKED_VERSION || 
+           header.tileSize != TILE_SIZE || header.format > FLOAT || (header.channels != 1 && header.channels != 3) || 
+           header.levels == 0 || size < sizeof(header) + header.levels * 2 * sizeof(uint64_t))
+            throw std::invalid_argument("The file " + bakedPath + " is not a baked texture");
+
+        this->format = static_cast<Format>(header.format);
+        this->channels = header.channels;
+
+        size_t firstTile = 0;
+        for(size_t i = 0; i < header.levels; ++i){
+            uint64_t dims[2];
+            std::memcpy(dims, data + sizeof(header) + i * sizeof(dims), sizeof(dims));
+            level_info lv{dims[0], dims[1], (dims[0] + TILE_SIZE - 1) / TILE_SIZE, (dims[1] + TILE_SIZE - 1) / TILE_SIZE, firstTile};
+            this->levels.push_back(lv);
+            firstTile += lv.tilesX * lv.tilesY;
+        }
+
+        const size_t headerBytes = sizeof(header) + header.levels * 2 * sizeof(uint64_t);
+        this->tilesOffset = (headerBytes + BAKED_ALIGNMENT - 1) / BAKED_ALIGNMENT * BAKED_ALIGNMENT;
+        if(size < this->tilesOffset + firstTile * this->getTileBytes())
+            throw std::invalid_argument("The file " + bakedPath + " is truncated");
+    }
+
+    /**
+     * @brief Destroys the mipmap and its store, and removes its tiles from the TileCache.
+     *
+     */
+    MipMap::~MipMap(){
+        // Only the mipmaps that are not mapped read their tiles through the cache.
+        if(this->mapping == nullptr)
+            TileCache::release(*this);
+    }
+
+    /**
+     * @brief Splits a level in tiles and appends them to the store. The tiles on the border are padded with zeros.
+     *
+     * @param data - The pixels of the level.
+     * @param lv - The level info.
+     */
+    void MipMap::writeLevel(const std::vector<unsigned char> &data, const level_info &lv){
+        const size_t texelBytes = this->getTexelBytes();
+        std::vector<unsigned char> tile(this->getTileBytes());
+
+        for(size_t ty = 0; ty < lv.tilesY; ++ty){
+            for(size_t tx = 0; tx < lv.tilesX; ++tx){
+                const size_t columns = std::min(TILE_SIZE, lv.width - tx * TILE_SIZE);
+                std::fill(tile.begin(), tile.end(), 0);
+
+                for(size_t row = 0; row < TILE_SIZE && ty * TILE_SIZE + row < lv.height; ++row)
+                    std::memcpy(tile.data() + row * TILE_SIZE * texelBytes,
+                                data.data() + ((ty * TILE_SIZE + row) * lv.width + tx * TILE_SIZE) * texelBytes, columns * texelBytes);
+
+                if(std::fwrite(tile.data(), 1, tile.size(), this->store.get()) != tile.size())
+                    throw std::runtime_error("Cannot write the mipmap tiles");
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the unique identifier of the mipmap.
+     *
+     * @return uint32_t - The identifier.
+     */
+    uint32_t MipMap::getId() const{
+        return this->id;
+    }
+
+    /**
+     * @brief Returns the width of the first level.
+     *
+     * @return size_t - The width.
+     */
+    size_t MipMap::getWidth() const{
+        return this->levels[0].width;
+    }
+
+    /**
+     * @brief Returns the height of the first level.
+     *
+     * @return size_t - The height.
+     */
+    size_t MipMap::getHeight() const{
+        return this->levels[0].height;
+    }
+
+    /**
+     * @brief Returns the number of levels of the pyramid.
+     *
+     * @return size_t - The number of levels.
+     */
+    size_t MipMap::getLevels() const{
+        return this->levels.size();
+    }
+
+    /**
+     * @brief Returns the number of channels of the texels.
+     *
+     * @return size_t - The number of channels, 1 or 3.
+     */
+    size_t MipMap::getChannels() const{
+        return this->channels;
+    }
+
+    /**
+     * @brief Returns the type of the texel components.
+     *
+     * @return Format - The type of the components.
+     */
+    MipMap::Format MipMap::getFormat() const{
+        return this->format;
+    }
+
+    /**
+     * @brief Returns the size of a texel.
+     *
+     * @return size_t - The size in bytes.
+     */
+    size_t MipMap::getTexelBytes() const{
+        switch(this->format){
+            case UINT16:    return this->channels * sizeof(uint16_t);
+            case FLOAT:     return this->channels * sizeof(float);
+            default:        return this->channels * sizeof(uint8_t);
+        }
+    }
+
+    /**
+     * @brief Returns the size of a tile.
+     *
+     * @return size_t - The size in bytes.
+     */
+    size_t MipMap::getTileBytes() const{
+        return TILE_SIZE * TILE_SIZE * this->getTexelBytes();
+    }
+
+    /**
+     * @brief Returns whether the tiles are read from a baked file mapped in memory.
+     *
+     * @return bool - True if the mipmap has been baked.
+     */
+    bool MipMap::isMapped() const{
+        return this->mapping != nullptr;
+    }
+
+    /**
+     * @brief Reads a tile from the store.
+     *
+     * @param level - The level of the tile.
+     * @param tx - The column of the tile.
+     * @param ty - The row of the tile.
+     * @param buffer - The buffer in which copy the tile. It must be getTileBytes() long.
+     */
+    void MipMap::readTile(const size_t level, const size_t tx, const size_t ty, unsigned char *buffer) const{
+        const level_info &lv = this->levels[level];
+        const size_t tileBytes = this->getTileBytes();
+
+        if(this->mapping != nullptr){
+            std::memcpy(buffer, this->getTileData(level, tx, ty), tileBytes);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(this->storeMutex);
+
+        std::fseek(this->store.get(), (lv.firstTile + ty * lv.tilesX + tx) * tileBytes, SEEK_SET);
+        if(std::fread(buffer, 1, tileBytes, this->store.get()) != tileBytes)
+            throw std::runtime_error("Cannot read the mipmap tiles");
+    }
+
+    /**
+     * @brief Writes the pyramid in a file that can be mapped later.
+     *
+     * @param path - The file to write.
+     */
+    void MipMap::bake(const std::string &path) const{
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if(file == nullptr)
+            throw std::invalid_argument("The file " + path + " cannot be written");
+
+        baked_header header;
+        std::memcpy(header.magic, BAKED_MAGIC, sizeof(BAKED_MAGIC));
+        header.version = BAKED_VERSION;
+        header.format = this->format;
+        header.channels = this->channels;
+        header.tileSize = TILE_SIZE;
+        header.levels = this->levels.size();
+
+        std::vector<unsigned char> bytes(sizeof(header) + this->levels.size() * 2 * sizeof(uint64_t));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        for(size_t i = 0; i < this->levels.size(); ++i){
+            const uint64_t dims[2] = {this->levels[i].width, this->levels[i].height};
+            std::memcpy(bytes.data() + sizeof(header) + i * sizeof(dims), dims, sizeof(dims));
+        }
+        bytes.resize((bytes.size() + BAKED_ALIGNMENT - 1) / BAKED_ALIGNMENT * BAKED_ALIGNMENT, 0);
+        bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+
+        bytes.resize(this->getTileBytes());
+        for(size_t level = 0; level < this->levels.size() && written; ++level)
+            for(size_t ty = 0; ty < this->levels[level].tilesY && written; ++ty)
+                for(size_t tx = 0; tx < this->levels[level].tilesX && written; ++tx){
+                    this->readTile(level, tx, ty, bytes.data());
+                    written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+                }
+
+        if(std::fclose(file) != 0 || !written)
+            throw std::runtime_error("Cannot write the file " + path);
+    }
+
+    /**
+     * @brief Returns the texels of a tile, from the mapped file or from the TileCache.
+     *
+     * @param level - The level of the tile.
+     * @param tx - The column of the tile.
+     * @param ty - The row of the tile.
+     * @return const unsigned char* - The texels. They are valid until TileCache::THREAD_WAYS other tiles are read
+     *                                 by the same thread.
+     */
+    const unsigned char *MipMap::getTileData(const size_t level, const size_t tx, const size_t ty) const{
+        if(this->mapping != nullptr){
+            const level_info &lv = this->levels[level];
+            return this->mapping->getData() + this->tilesOffset + (lv.firstTile + ty * lv.tilesX + tx) * this->getTileBytes();
+        }
+
+        return TileCache::getTile(*this, level, tx, ty).data();
+    }
+
+    /**
+     * @brief Returns the color of a texel, clamping the coords inside the level.
+     *
+     * @param level - The level.
+     * @param x - The column of the texel.
+     * @param y - The row of the texel.
+     * @return Vec3 - The color, in a range from 0 to 1 if the image is not HDR.
+     */
+    Vec3 MipMap::texel(const size_t level, int x, int y) const{
+        const level_info &lv = this->levels[level];
+        x = x < 0 ? 0 : x >= int(lv.width) ? lv.width - 1 : x;
+        y = y < 0 ? 0 : y >= int(lv.height) ? lv.height - 1 : y;
+
+        const unsigned char *tile = this->getTileData(level, x / TILE_SIZE, y / TILE_SIZE);
+        const size_t offset = (y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE;
+        float color[3];
+
+        for(size_t c = 0; c < this->channels; ++c){
+            switch(this->format){
+                case UINT8:     color[c] = toFloat(tile[offset * this->channels + c]); break;
+                case UINT16:    color[c] = toFloat(reinterpret_cast<const uint16_t*>(tile)[offset * this->channels + c]); break;
+                case FLOAT:     color[c] = reinterpret_cast<const float*>(tile)[offset * this->channels + c]; break;
+            }
+        }
+
+        return this->channels == 1 ? Vec3{color[0]} : Vec3{color[0], color[1], color[2]};
+    }
+
+    /**
+     * @brief Returns the bilinear interpolation of the four texels around a point of a level.
+     *
+     * @param level - The level.
+     * @param u - The x texture coord. Ranged from 0 to 1.
+     * @param v - The y texture coord. Ranged from 0 to 1.
+     * @return Vec3 - The filtered color.
+     */
+    Vec3 MipMap::bilinear(const size_t level, const float u, const float v) const{
+        const level_info &lv = this->levels[level];
+        // The u/v coords are computed from bottom-left angle, we have it as upper left angle as origin.
+        const float x = u * lv.width - 0.5f, y = (1 - v) * lv.height - 0.5f;
+        const int x0 = std::floor(x), y0 = std::floor(y);
+        const float fx = x - x0, fy = y - y0;
+
+        return (1 - fy) * ((1 - fx) * this->texel(level, x0, y0) + fx * this->texel(level, x0 + 1, y0)) +
+               fy * ((1 - fx) * this->texel(level, x0, y0 + 1) + fx * this->texel(level, x0 + 1, y0 + 1));
+    }
+
+    /**
+     * @brief Returns the color of the image in a point, filtered on the area covered by the footprint.
+     *        The two levels closer to the footprint are interpolated (trilinear filtering).
+     *
+     * @param u - The x texture coord. Ranged from 0 to 1.
+     * @param v - The y texture coord. Ranged from 0 to 1.
+     * @param footprint - The width of the filtered area in texture coords.
+     * @return Vec3 - The filtered color.
+     */
+    Vec3 MipMap::sample(const float u, const float v, const float footprint) const{
+        const float lod = footprint > 0 ? std::log2(footprint * std::max(this->getWidth(), this->getHeight())) : 0;
+        const size_t last = this->levels.size() - 1;
+
+        if(lod <= 0)            return this->bilinear(0, u, v);
+        if(lod >= last)         return this->bilinear(last, u, v);
+
+        const size_t level = static_cast<size_t>(lod);
+        const float f = lod - level;
+        return (1 - f) * this->bilinear(level, u, v) + f * this->bilinear(level + 1, u, v);
+    }
+
+}
+}
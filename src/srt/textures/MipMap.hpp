@@ -0,0 +1,103 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MIPMAP HEADER FILE                                 *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_TEXTURES_MIPMAP_S
+#define S_TEXTURES_MIPMAP_S
+
+// System includes.
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// My includes.
+#include "../geometry/Vec3.hpp"
+#include "../utility/MappedFile.hpp"
+
+namespace srt{
+namespace textures{
+
+/// This class represents the mip pyramid of an image. Every level is split in square tiles that
+/// are written in a backing store, so that the image does not stay in memory: the tiles are read back
+/// on demand through the TileCache. 
+/// The texels keep the precision of the source image and have one channel for gray images and three
+/// for colored ones (the alpha channel is dropped).
+/// A pyramid can be baked in a file and mapped back in memory: in this case the tiles are read
+/// straight from the mapped file, without decoding the image nor going through the TileCache.
+class MipMap{
+public:
+    // CONSTANTS
+
+    static constexpr size_t TILE_SIZE = 64;
+    static constexpr uint32_t BAKED_VERSION = 1;
+    static constexpr size_t BAKED_ALIGNMENT = 4096;
+
+    // ENUMERATIONS
+
+    /// The type of the texel components.
+    enum Format {UINT8, UINT16, FLOAT};
+
+    // STRUCTURES
+
+    /// The info about a level of the pyramid.
+    typedef struct li{
+        size_t width, height, tilesX, tilesY, firstTile;
+    } level_info;
+
+private:
+    // ATTRIBUTES
+
+    uint32_t id;
+    Format format;
+    size_t channels;
+    std::vector<level_info> levels;
+    // Closed also when a constructor throws after opening it.
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> store;
+    mutable std::mutex storeMutex;
+    std::unique_ptr<utility::MappedFile> mapping;
+    size_t tilesOffset;
+
+    // METHODS
+
+    void writeLevel(const std::vector<unsigned char> &data, const level_info &lv);
+    const unsigned char *getTileData(const size_t level, const size_t tx, const size_t ty) const;
+    geometry::Vec3 texel(const size_t level, int x, int y) const;
+    geometry::Vec3 bilinear(const size_t level, const float u, const float v) const;
+
+public:
+    // CONSTRUCTORS
+
+    MipMap(const void *data, const size_t width, const size_t height, const size_t sourceChannels, 
+           const Format format = UINT8);
+    MipMap(const std::string &bakedPath);
+    MipMap(const MipMap &old) = delete;
+    ~MipMap();
+
+    // METHODS
+
+    uint32_t getId() const;
+    size_t getWidth() const;
+    size_t getHeight() const;
+    size_t getLevels() const;
+    size_t getChannels() const;
+    Format getFormat() const;
+    size_t getTexelBytes() const;
+    size_t getTileBytes() const;
+    bool isMapped() const;
+    void readTile(const size_t level, const size_t tx, const size_t ty, unsigned char *buffer) const;
+    void bake(const std::string &path) const;
+    geometry::Vec3 sample(const float u, const float v, const float footprint) const;
+};
+
+}
+}
+
+#endif
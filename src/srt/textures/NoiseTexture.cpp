@@ -0,0 +1,114 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  NOISE TEXTURE CLASS FILE                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "NoiseTexture.hpp"
+
+// Other system includes.
+#include <algorithm>
+#include <cmath>
+
+using namespace srt::geometry;
+
+namespace srt{
+namespace textures{
+
+    /**
+     * @brief Constructs a new Noise Texture.
+     * 
+     * @param pattern - The pattern.
+     * @param scale - The frequency of the pattern.
+     * @param octaves - The octaves of noise summed by the fractal patterns.
+     * @param c0 - The color where the pattern is 0.
+     * @param c1 - The color where the pattern is 1.
+     */
+    NoiseTexture::NoiseTexture(const Pattern pattern, const float scale, const size_t octaves, const Vec3 &c0, const Vec3 &c1) :
+        pattern(pattern), scale(scale), octaves(octaves), c0(c0), c1(c1) {}
+
+    /**
+     * @brief Returns the value of the pattern in a point.
+     * 
+     * @param p - The point.
+     * @return float - The value, in a range from 0 to 1.
+     */
+    float NoiseTexture::blend(const Vec3 &p) const{
+        float x = p.x(), y = p.y(), z = p.z(), result;
+        this->blend(&x, &y, &z, &result, 1);
+        return result;
+    }
+
+    /**
+     * @brief Returns the value of the pattern in many points, evaluating the noise Perlin::LANES points at a time.
+     * 
+     * @param x - The x coords of the points.
+     * @param y - The y coords of the points.
+     * @param z - The z coords of the points.
+     * @param result - The value in every point, in a range from 0 to 1.
+     * @param n - The number of points.
+     */
+    void NoiseTexture::blend(const float *x, const float *y, const float *z, float *result, const size_t n) const{
+        for(size_t i = 0; i < n; i += Perlin::LANES){
+            const size_t lanes = std::min(Perlin::LANES, n - i);
+            float sx[Perlin::LANES], sy[Perlin::LANES], sz[Perlin::LANES], noise[Perlin::LANES];
+
+            for(size_t l = 0; l < lanes; ++l){
+                sx[l] = this->scale * x[i + l];
+                sy[l] = this->scale * y[i + l];
+                sz[l] = this->scale * z[i + l];
+            }
+
+            switch(this->pattern){
+                case NOISE:
+                    Perlin::noise(sx, sy, sz, noise, lanes);
+                    for(size_t l = 0; l < lanes; ++l)
+                        result[i + l] = 0.5f * (1 + noise[l]);
+                    break;
+                case FBM:
+                    Perlin::fbm(sx, sy, sz, noise, lanes, this->octaves);
+                    for(size_t l = 0; l < lanes; ++l)
+                        result[i + l] = std::min(1.f, std::max(0.f, 0.5f * (1 + noise[l])));
+                    break;
+                case TURBULENCE:
+                    Perlin::turbulence(sx, sy, sz, noise, lanes, this->octaves);
+                    for(size_t l = 0; l < lanes; ++l)
+                        result[i + l] = std::min(1.f, noise[l]);
+                    break;
+                case MARBLE:
+                    // Stripes along z, distorted by the turbulence.
+                    Perlin::turbulence(sx, sy, sz, noise, lanes, this->octaves);
+                    for(size_t l = 0; l < lanes; ++l)
+                        result[i + l] = 0.5f * (1 + std::sin(sz[l] + 10 * noise[l]));
+                    break;
+                case WOOD:
+                    // Rings around the y axis, distorted by the fbm.
+                    Perlin::fbm(sx, sy, sz, noise, lanes, this->octaves);
+                    for(size_t l = 0; l < lanes; ++l){
+                        const float rings = 4 * std::sqrt(sx[l] * sx[l] + sz[l] * sz[l]) + noise[l];
+                        result[i + l] = rings - std::floor(rings);
+                    }
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns an RGB value that represents the color of the texture in that point.
+     * 
+     * @param u - The x texture coord. Ranged from 0 to 1.
+     * @param v - The y texture coord. Ranged from 0 to 1.
+     * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords.
+     * @return geometry::Vec3 - The color of the texture.
+     */
+    Vec3 NoiseTexture::value(const float u, const float v, const Vec3 &p, const float footprint) const{
+        const float t = this->blend(p);
+        return (1 - t) * this->c0 + t * this->c1;
+    }
+
+}
+}
@@ -0,0 +1,53 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  NOISE TEXTURE HEADER FILE                          *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_TEXTURES_NOISETEXTURE_S
+#define S_TEXTURES_NOISETEXTURE_S
+
+// My includes.
+#include "Texture.hpp"
+#include "Perlin.hpp"
+
+namespace srt{
+namespace textures{
+
+/// This represents a procedural texture built on the Perlin noise. The pattern gives a value from
+/// 0 to 1 in every point of the space, that blends two colors.
+class NoiseTexture : public Texture{
+public:
+    // ENUMERATIONS
+
+    /// The patterns of the texture.
+    enum Pattern {NOISE, FBM, TURBULENCE, MARBLE, WOOD};
+
+private:
+    // ATTRIBUTES
+
+    Pattern pattern;
+    float scale;
+    size_t octaves;
+    geometry::Vec3 c0, c1;
+
+public:
+    // CONSTRUCTORS
+
+    NoiseTexture(const Pattern pattern = NOISE, const float scale = 1, const size_t octaves = Perlin::DEFAULT_OCTAVES,
+                 const geometry::Vec3 &c0 = {0, 0, 0}, const geometry::Vec3 &c1 = {1, 1, 1});
+
+    // METHODS
+
+    float blend(const geometry::Vec3 &p) const;
+    void blend(const float *x, const float *y, const float *z, float *result, const size_t n) const;
+    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const;
+};
+
+}
+}
+
+#endif
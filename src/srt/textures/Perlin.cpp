@@ -0,0 +1,219 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PERLIN NOISE CLASS FILE                            *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "Perlin.hpp"
+
+// Other system includes.
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+using namespace srt::geometry;
+
+namespace srt{
+namespace textures{
+
+    const std::array<int32_t, 512> Perlin::permutation = Perlin::buildPermutation();
+
+    /**
+     * @brief Returns a random permutation of the numbers from 0 to 255, repeated twice so that
+     *        the lookups never need to wrap. The seed is fixed, so the noise is the same at every run.
+     *
+     * @return std::array<int32_t, 512> - The permutation.
+     */
+    std::array<int32_t, 512> Perlin::buildPermutation(){
+        std::array<int32_t, 512> result;
+        std::mt19937 generator(1985);
+
+        for(int32_t i = 0; i < 256; ++i)
+            result[i] = i;
+        std::shuffle(result.begin(), result.begin() + 256, generator);
+        std::copy(result.begin(), result.begin() + 256, result.begin() + 256);
+
+        return result;
+    }
+
+    static inline float fade(const float t){
+        return t * t * t * (t * (t * 6 - 15) + 10);
+    }
+
+    static inline float lerp(const float t, const float a, const float b){
+        return a + t * (b - a);
+    }
+
+    /**
+     * @brief Returns the dot product between the offset and one of the 12 edge directions of a cube,
+     *        chosen by the hash. It uses only selects, so that it can be vectorized.
+     */
+    static inline float grad(const int32_t hash, const float x, const float y, const float z){
+        const int32_t h = hash & 15;
+        const float u = h < 8 ? x : y;
+        const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+        return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+    }
+
+    /**
+     * @brief Evaluates the noise in N points. The loop has no branches nor calls, so the compiler
+     *        runs the N points in the SIMD lanes.
+     *
+     * @param perm - The permutation table.
+     * @param x - The x coords of the points.
+     * @param y - The y coords of the points.
+     * @param z - The z coords of the points.
+     * @param frequency - The factor applied to the coords.
+     * @param result - The noise in every point, in a range from -1 to 1.
+     */
+    template<size_t N>
+    static inline void kernel(const int32_t *perm, const float *x, const float *y, const float *z, const float frequency,
+                              float *result){
+        for(size_t i = 0; i < N; ++i){
+            const float px = x[i] * frequency, py = y[i] * frequency, pz = z[i] * frequency;
+            // Floor without calls: truncate and fix the negative numbers.
+            const int32_t ix = int32_t(px) - (px < int32_t(px)), iy = int32_t(py) - (py < int32_t(py)),
+                          iz = int32_t(pz) - (pz < int32_t(pz));
+            const float fx = px - ix, fy = py - iy, fz = pz - iz;
+            const int32_t X = ix & 255, Y = iy & 255, Z = iz & 255;
+            const float u = fade(fx), v = fade(fy), w = fade(fz);
+
+            const int32_t A = perm[X] + Y, AA = perm[A] + Z, AB = perm[A + 1] + Z;
+            const int32_t B = perm[X + 1] + Y, BA = perm[B] + Z, BB = perm[B + 1] + Z;
+
+            result[i] = lerp(w, lerp(v, lerp(u, grad(perm[AA], fx, fy, fz), grad(perm[BA], fx - 1, fy, fz)),
+                                        lerp(u, grad(perm[AB], fx, fy - 1, fz), grad(perm[BB], fx - 1, fy - 1, fz))),
+                                lerp(v, lerp(u, grad(perm[AA + 1], fx, fy, fz - 1), grad(perm[BA + 1], fx - 1, fy, fz - 1)),
+                                        lerp(u, grad(perm[AB + 1], fx, fy - 1, fz - 1), grad(perm[BB + 1], fx - 1, fy - 1, fz - 1))));
+        }
+    }
+
+    /**
+     * @brief Sums N points of several octaves of noise, each with double frequency and half weight of the previous.
+     *
+     * @param absolute - If true, sums the absolute value of the noise (turbulence).
+     */
+    template<size_t N>
+    static inline void octaves(const int32_t *perm, const float *x, const float *y, const float *z, float *result,
+                               const size_t count, const bool absolute){
+        float octave[N];
+        float frequency = 1, weight = 1;
+
+        std::fill(result, result + N, 0.f);
+        for(size_t o = 0; o < count; ++o){
+            kernel<N>(perm, x, y, z, frequency, octave);
+            for(size_t i = 0; i < N; ++i)
+                result[i] += weight * (absolute ? std::abs(octave[i]) : octave[i]);
+            frequency *= 2;
+            weight *= 0.5f;
+        }
+    }
+
+    /**
+     * @brief Runs a kernel on n points, LANES at a time, then 4 at a time, then one by one.
+     */
+    template<typename F>
+    static inline void batch(const float *x, const float *y, const float *z, float *result, const size_t n, F run){
+        size_t i = 0;
+        for(; i + Perlin::LANES <= n; i += Perlin::LANES)
+            run(std::integral_constant<size_t, Perlin::LANES>(), x + i, y + i, z + i, result + i);
+        for(; i + 4 <= n; i += 4)
+            run(std::integral_constant<size_t, 4>(), x + i, y + i, z + i, result + i);
+        for(; i < n; ++i)
+            run(std::integral_constant<size_t, 1>(), x + i, y + i, z + i, result + i);
+    }
+
+    /**
+     * @brief Returns the noise in a point.
+     *
+     * @param p - The point.
+     * @return float - The noise, in a range from -1 to 1.
+     */
+    float Perlin::noise(const Vec3 &p){
+        float result;
+        kernel<1>(permutation.data(), &p.x(), &p.y(), &p.z(), 1, &result);
+        return result;
+    }
+
+    /**
+     * @brief Returns the fractal brownian motion in a point: a sum of octaves of noise.
+     *
+     * @param p - The point.
+     * @param octaves - The number of octaves.
+     * @return float - The sum, in a range from -2 to 2.
+     */
+    float Perlin::fbm(const Vec3 &p, const size_t octaves){
+        float result;
+        textures::octaves<1>(permutation.data(), &p.x(), &p.y(), &p.z(), &result, octaves, false);
+        return result;
+    }
+
+    /**
+     * @brief Returns the turbulence in a point: a sum of octaves of the absolute noise.
+     *
+     * @param p - The point.
+     * @param octaves - The number of octaves.
+     * @return float - The sum, in a range from 0 to 2.
+     */
+    float Perlin::turbulence(const Vec3 &p, const size_t octaves){
+        float result;
+        textures::octaves<1>(permutation.data(), &p.x(), &p.y(), &p.z(), &result, octaves, true);
+        return result;
+    }
+
+    /**
+     * @brief Evaluates the noise in many points.
+     *
+     * @param x - The x coords of the points.
+     * @param y - The y coords of the points.
+     * @param z - The z coords of the points.
+     * @param result - The noise in every point.
+     * @param n - The number of points.
+     */
+    void Perlin::noise(const float *x, const float *y, const float *z, float *result, const size_t n){
+        const int32_t *perm = permutation.data();
+        batch(x, y, z, result, n, [perm](auto lanes, const float *x, const float *y, const float *z, float *result){
+            kernel<decltype(lanes)::value>(perm, x, y, z, 1, result);
+        });
+    }
+
+    /**
+     * @brief Evaluates the fractal brownian motion in many points.
+     *
+     * @param x - The x coords of the points.
+     * @param y - The y coords of the points.
+     * @param z - The z coords of the points.
+     * @param result - The sum in every point.
+     * @param n - The number of points.
+     * @param octaves - The number of octaves.
+     */
+    void Perlin::fbm(const float *x, const float *y, const float *z, float *result, const size_t n, const size_t octaves){
+        const int32_t *perm = permutation.data();
+        batch(x, y, z, result, n, [perm, octaves](auto lanes, const float *x, const float *y, const float *z, float *result){
+            textures::octaves<decltype(lanes)::value>(perm, x, y, z, result, octaves, false);
+        });
+    }
+
+    /**
+     * @brief Evaluates the turbulence in many points.
+     *
+     * @param x - The x coords of the points.
+     * @param y - The y coords of the points.
+     * @param z - The z coords of the points.
+     * @param result - The sum in every point.
+     * @param n - The number of points.
+     * @param octaves - The number of octaves.
+     */
+    void Perlin::turbulence(const float *x, const float *y, const float *z, float *result, const size_t n, const size_t octaves){
+        const int32_t *perm = permutation.data();
+        batch(x, y, z, result, n, [perm, octaves](auto lanes, const float *x, const float *y, const float *z, float *result){
+            textures::octaves<decltype(lanes)::value>(perm, x, y, z, result, octaves, true);
+        });
+    }
+
+}
+}
@@ -0,0 +1,59 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PERLIN NOISE HEADER FILE                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_TEXTURES_PERLIN_S
+#define S_TEXTURES_PERLIN_S
+
+// System includes.
+#include <array>
+#include <cstdint>
+
+// My includes.
+#include "../geometry/Vec3.hpp"
+
+namespace srt{
+namespace textures{
+
+/// This class offers only static methods to evaluate the (improved) Perlin gradient noise, and the
+/// fractal sums built on it. The batch methods evaluate LANES points at a time with a branchless
+/// kernel that the compiler turns into SIMD code. The permutation table is shared by all the textures.
+class Perlin{
+public:
+    // CONSTANTS
+
+    static constexpr size_t LANES = 8;
+    static constexpr size_t DEFAULT_OCTAVES = 7;
+
+private:
+    // ATTRIBUTES
+
+    static const std::array<int32_t, 512> permutation;
+
+    // METHODS
+
+    static std::array<int32_t, 512> buildPermutation();
+
+public:
+    // METHODS
+
+    static float noise(const geometry::Vec3 &p);
+    static float fbm(const geometry::Vec3 &p, const size_t octaves = DEFAULT_OCTAVES);
+    static float turbulence(const geometry::Vec3 &p, const size_t octaves = DEFAULT_OCTAVES);
+
+    static void noise(const float *x, const float *y, const float *z, float *result, const size_t n);
+    static void fbm(const float *x, const float *y, const float *z, float *result, const size_t n,
+                    const size_t octaves = DEFAULT_OCTAVES);
+    static void turbulence(const float *x, const float *y, const float *z, float *result, const size_t n,
+                           const size_t octaves = DEFAULT_OCTAVES);
+};
+
+}
+}
+
+#endif
@@ -25,15 +25,25 @@ namespace textures{
      */
     StaticTexture::StaticTexture(const geometry::Vec3 &color) : color(color) {} 
 
+    /**
+     * @brief Returns the color of the texture.
+     * 
+     * @return const geometry::Vec3& - The color.
+     */
+    const geometry::Vec3 &StaticTexture::getColor() const{
+        return this->color;
+    }
+
     /**
      * @brief Return an RGB value that represents the color of the texture (it is always the same).
      * 
      * @param u - The x texture coord. Ranged from 0 to 1.
      * @param v - The y texture coord. Ranged from 0 to 1.
      * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords.
      * @return geometry::Vec3 - The color of the texture.
      */
-    geometry::Vec3 StaticTexture::value(const float u, const float v, const geometry::Vec3 &p) const{
+    geometry::Vec3 StaticTexture::value(const float u, const float v, const geometry::Vec3 &p, const float footprint) const{
         return this->color;
     }
 
@@ -25,7 +25,10 @@ public:
     StaticTexture();
     StaticTexture(const geometry::Vec3 &color);
 
-    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p) const;
+    // METHODS
+
+    const geometry::Vec3 &getColor() const;
+    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const;
 };
 
 }
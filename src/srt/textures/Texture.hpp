@@ -25,9 +25,10 @@ public:
      * @param u - The x texture coord. Ranged from 0 to 1.
      * @param v - The y texture coord. Ranged from 0 to 1.
      * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords. 0 means no filtering.
      * @return geometry::Vec3 - The color of the texture.
      */
-    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p) const = 0;
+    virtual geometry::Vec3 value(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const = 0;
 };
 
 }
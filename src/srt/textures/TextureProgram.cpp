@@ -0,0 +1,111 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TEXTURE PROGRAM CLASS FILE                         *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "TextureProgram.hpp"
+
+// Other system includes.
+#include <cmath>
+
+// My other includes.
+#include "CheckerTexture.hpp"
+#include "ImageTexture.hpp"
+#include "NoiseTexture.hpp"
+#include "StaticTexture.hpp"
+
+using namespace srt::geometry;
+
+namespace srt{
+namespace textures{
+
+    /**
+     * @brief Constructs a program that always returns black.
+     * 
+     */
+    TextureProgram::TextureProgram() : code{{CONSTANT, 0, {0, 0, 0}, nullptr}} {}
+
+    /**
+     * @brief Compiles a tree of textures.
+     * 
+     * @param texture - The root of the tree.
+     */
+    TextureProgram::TextureProgram(const Texture &texture){
+        this->emit(texture);
+    }
+
+    /**
+     * @brief Appends the instructions of a texture (and of its children) to the program.
+     * 
+     * @param texture - The texture to compile.
+     */
+    void TextureProgram::emit(const Texture &texture){
+        if(auto constant = dynamic_cast<const StaticTexture*>(&texture))
+            this->code.push_back({CONSTANT, 0, constant->getColor(), nullptr});
+        else if(auto checker = dynamic_cast<const CheckerTexture*>(&texture)){
+            const size_t position = this->code.size();
+            this->code.push_back({CHECKER, 0, {0, 0, 0}, nullptr});
+            this->emit(*checker->getFirst());
+            this->code[position].next = this->code.size();
+            this->emit(*checker->getSecond());
+
+            // A checker between two equal colors is just that color.
+            const instruction first = this->code[position + 1], second = this->code.back();
+            if(this->code.size() == position + 3 && first.op == CONSTANT && second.op == CONSTANT && first.color == second.color){
+                this->code.resize(position);
+                this->code.push_back(first);
+            }
+        }
+        else if(dynamic_cast<const ImageTexture*>(&texture))
+            this->code.push_back({IMAGE, 0, {0, 0, 0}, &texture});
+        else if(dynamic_cast<const NoiseTexture*>(&texture))
+            this->code.push_back({NOISE, 0, {0, 0, 0}, &texture});
+        else
+            this->code.push_back({CALL, 0, {0, 0, 0}, &texture});
+    }
+
+    /**
+     * @brief Returns the instructions of the program.
+     * 
+     * @return const std::vector<instruction>& - The instructions, starting from the root.
+     */
+    const std::vector<TextureProgram::instruction> &TextureProgram::getCode() const{
+        return this->code;
+    }
+
+    /**
+     * @brief Returns an RGB value that represents the color of the compiled textures in that point.
+     * 
+     * @param u - The x texture coord. Ranged from 0 to 1.
+     * @param v - The y texture coord. Ranged from 0 to 1.
+     * @param p - The point hit on the object.
+     * @param footprint - The width of the area to filter, in texture coords.
+     * @return Vec3 - The color of the textures.
+     */
+    Vec3 TextureProgram::evaluate(const float u, const float v, const Vec3 &p, const float footprint) const{
+        const instruction *in = this->code.data();
+
+        while(true){
+            switch(in->op){
+                case CONSTANT:
+                    return in->color;
+                case CHECKER:
+                    in = CheckerTexture::isFirst(p) ? in + 1 : this->code.data() + in->next;
+                    break;
+                case IMAGE:
+                    // Qualified call, so that it is not dispatched through the virtual table.
+                    return static_cast<const ImageTexture*>(in->texture)->ImageTexture::value(u, v, p, footprint);
+                case NOISE:
+                    return static_cast<const NoiseTexture*>(in->texture)->NoiseTexture::value(u, v, p, footprint);
+                default:
+                    return in->texture->value(u, v, p, footprint);
+            }
+        }
+    }
+
+}
+}
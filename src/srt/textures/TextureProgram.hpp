@@ -0,0 +1,68 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TEXTURE PROGRAM HEADER FILE                        *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_TEXTURES_TEXTUREPROGRAM_S
+#define S_TEXTURES_TEXTUREPROGRAM_S
+
+// System includes.
+#include <cstdint>
+#include <vector>
+
+// My includes.
+#include "Texture.hpp"
+
+namespace srt{
+namespace textures{
+
+/// A tree of textures flattened in an array of instructions, which is evaluated by a single loop
+/// instead of a chain of virtual calls. The known textures are compiled in their own instructions,
+/// the others are called through their value method.
+/// The program does not own the textures, so they must outlive it.
+class TextureProgram{
+public:
+    // ENUMERATIONS
+
+    /// The operations of the instructions.
+    enum OpCode : uint8_t {CONSTANT, CHECKER, IMAGE, NOISE, CALL};
+
+    // STRUCTURES
+
+    /// An instruction. A CHECKER is followed by its first child, while next is the index of the second one.
+    typedef struct in{
+        OpCode op;
+        uint32_t next;
+        geometry::Vec3 color;
+        const Texture *texture;
+    } instruction;
+
+private:
+    // ATTRIBUTES
+
+    std::vector<instruction> code;
+
+    // METHODS
+
+    void emit(const Texture &texture);
+
+public:
+    // CONSTRUCTORS
+
+    TextureProgram();
+    TextureProgram(const Texture &texture);
+
+    // METHODS
+
+    const std::vector<instruction> &getCode() const;
+    geometry::Vec3 evaluate(const float u, const float v, const geometry::Vec3 &p, const float footprint = 0) const;
+};
+
+}
+}
+
+#endif
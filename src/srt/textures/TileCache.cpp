@@ -0,0 +1,171 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TILE CACHE CLASS FILE                              *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "TileCache.hpp"
+
+// My other includes.
+#include "MipMap.hpp"
+
+namespace srt{
+namespace textures{
+
+    std::mutex TileCache::mutex;
+    std::list<TileCache::entry> TileCache::tiles;
+    std::unordered_map<uint64_t, std::list<TileCache::entry>::iterator> TileCache::index;
+    size_t TileCache::budget = TileCache::DEFAULT_BUDGET, TileCache::memory = 0, TileCache::hits = 0, TileCache::misses = 0;
+    std::atomic<uint64_t> TileCache::releases{0};
+
+    /**
+     * @brief Returns a tile of a mipmap, reading it from the mipmap store if it is not cached.
+     *        The last THREAD_WAYS tiles used by every thread are kept aside, so that the lookups in
+     *        the same tiles do not need to lock the cache; the oldest one is replaced first.
+     *
+     * @param mipmap - The mipmap owning the tile.
+     * @param level - The level of the mipmap.
+     * @param tx - The column of the tile in the level.
+     * @param ty - The row of the tile in the level.
+     * @return const Tile& - The tile. It is valid until THREAD_WAYS other tiles are looked up by the same thread.
+     */
+    const TileCache::Tile& TileCache::getTile(const MipMap &mipmap, const size_t level, const size_t tx, const size_t ty){
+        thread_local line lines[THREAD_WAYS];
+        thread_local size_t oldest = 0;
+        thread_local uint64_t released = 0;
+        const uint64_t key = (uint64_t(mipmap.getId()) << 32) | (uint64_t(level) << 24) | (ty << 12) | tx;
+
+        // Drop the tiles kept aside if a mipmap has released its tiles since the last lookup.
+        const uint64_t currentReleases = releases.load(std::memory_order_acquire);
+        if(released != currentReleases){
+            for(line &l : lines)
+                l = {};
+            released = currentReleases;
+        }
+
+        for(const line &l : lines)
+            if(l.key == key)
+                return *l.tile;
+
+        line &slot = lines[oldest];
+        oldest = (oldest + 1) % THREAD_WAYS;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = index.find(key);
+            if(it != index.end()){
+                // Mark the tile as the most recently used.
+                tiles.splice(tiles.begin(), tiles, it->second);
+                ++hits;
+                slot = {key, it->second->second};
+                return *slot.tile;
+            }
+            ++misses;
+        }
+
+        // Read the tile without holding the lock, so that other threads can go on.
+        auto tile = std::make_shared<Tile>(mipmap.getTileBytes());
+        mipmap.readTile(level, tx, ty, tile->data());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if(it == index.end()){
+            tiles.emplace_front(key, tile);
+            index[key] = tiles.begin();
+            memory += tile->size();
+            evict();
+            slot = {key, tile};
+        }
+        else    // Another thread has already read the tile.
+            slot = {key, it->second->second};
+
+        return *slot.tile;
+    }
+
+    /**
+     * @brief Removes all the tiles of a mipmap from the cache, when it is destroyed. The threads drop
+     *        the tiles they have kept aside at their next lookup.
+     *
+     * @param mipmap - The mipmap.
+     */
+    void TileCache::release(const MipMap &mipmap){
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto it = tiles.begin(); it != tiles.end();){
+            if(it->first >> 32 == mipmap.getId()){
+                memory -= it->second->size();
+                index.erase(it->first);
+                it = tiles.erase(it);
+            }
+            else
+                ++it;
+        }
+        releases.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes the least recently used tiles until the memory is within the budget.
+     *        The lock must be held by the caller.
+     */
+    void TileCache::evict(){
+        while(memory > budget && tiles.size() > 1){
+            memory -= tiles.back().second->size();
+            index.erase(tiles.back().first);
+            tiles.pop_back();
+        }
+    }
+
+    /**
+     * @brief Sets the maximum memory used by the cached tiles.
+     *
+     * @param bytes - The budget in bytes.
+     */
+    void TileCache::setBudget(const size_t bytes){
+        std::lock_guard<std::mutex> lock(mutex);
+        budget = bytes;
+        evict();
+    }
+
+    /**
+     * @brief Returns the maximum memory used by the cached tiles.
+     *
+     * @return size_t - The budget in bytes.
+     */
+    size_t TileCache::getBudget(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return budget;
+    }
+
+    /**
+     * @brief Returns the memory currently used by the cached tiles.
+     *
+     * @return size_t - The memory in bytes.
+     */
+    size_t TileCache::getMemory(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return memory;
+    }
+
+    /**
+     * @brief Returns the number of lookups that found the tile in the cache.
+     *
+     * @return size_t - The number of hits.
+     */
+    size_t TileCache::getHits(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    /**
+     * @brief Returns the number of lookups that had to read the tile from its mipmap.
+     *
+     * @return size_t - The number of misses.
+     */
+    size_t TileCache::getMisses(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+}
+}
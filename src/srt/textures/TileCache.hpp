@@ -0,0 +1,79 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TILE CACHE HEADER FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_TEXTURES_TILECACHE_S
+#define S_TEXTURES_TILECACHE_S
+
+// System includes.
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace srt{
+namespace textures{
+
+class MipMap;
+
+/// This class offers only static methods to access the tiles of the mipmaps. The tiles are kept
+/// in a LRU cache shared by all the mipmaps, whose memory never exceeds a fixed budget.
+/// Every thread keeps aside the last THREAD_WAYS tiles it has used, so that the lookups of a
+/// trilinear sample, in up to four tiles of two levels, do not need to lock the cache.
+/// A mipmap releases its tiles when it is destroyed, and the threads drop the tiles they keep aside.
+class TileCache{
+public:
+    // TYPEDEF
+
+    typedef std::vector<unsigned char> Tile;
+
+    // CONSTANTS
+
+    static constexpr size_t DEFAULT_BUDGET = 256 << 20;
+    static constexpr size_t THREAD_WAYS = 8;
+
+private:
+    // ATTRIBUTES
+
+    typedef std::pair<uint64_t, std::shared_ptr<const Tile>> entry;
+
+    /// A tile kept aside by a thread.
+    typedef struct ln{
+        uint64_t key = UINT64_MAX;
+        std::shared_ptr<const Tile> tile;
+    } line;
+
+    static std::mutex mutex;
+    static std::list<entry> tiles;
+    static std::unordered_map<uint64_t, std::list<entry>::iterator> index;
+    static size_t budget, memory, hits, misses;
+    static std::atomic<uint64_t> releases;
+
+    // METHODS
+
+    static void evict();
+
+public:
+    // METHODS
+
+    static const Tile &getTile(const MipMap &mipmap, const size_t level, const size_t tx, const size_t ty);
+    static void release(const MipMap &mipmap);
+    static void setBudget(const size_t bytes);
+    static size_t getBudget();
+    static size_t getMemory();
+    static size_t getHits();
+    static size_t getMisses();
+};
+
+}
+}
+
+#endif
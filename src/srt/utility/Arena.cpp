@@ -0,0 +1,104 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  ARENA CLASS FILE                                   *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "Arena.hpp"
+
+// System includes.
+#include <algorithm>
+#include <cstdint>
+
+namespace srt{
+namespace utility{
+
+    /**
+     * @brief Construct a new empty Arena object. No memory is reserved until the first allocation.
+     *
+     * @param blockSize - The size of the blocks. A larger object gets a block of its own.
+     */
+    Arena::Arena(const size_t blockSize) : current(0), blockSize(blockSize), allocations(0), used(0), wasted(0) { }
+
+    /**
+     * @brief Reserves the memory for an object at the end of the current block, or in a new block
+     *        if the current one is full.
+     *
+     * @param size - The size of the object.
+     * @param alignment - The alignment of the object, a power of 2.
+     * @return void* - The memory of the object.
+     */
+    void *Arena::allocate(const size_t size, const size_t alignment){
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        while(true){
+            if(this->current < this->blocks.size()){
+                block &b = this->blocks[this->current];
+                const uintptr_t start = reinterpret_cast<uintptr_t>(b.data.get()) + b.offset;
+                const size_t padding = (alignment - start % alignment) % alignment;
+                if(b.offset + padding + size <= b.size){
+                    b.offset += padding + size;
+                    this->wasted += padding;
+                    this->used += size;
+                    ++this->allocations;
+                    return reinterpret_cast<void*>(start + padding);
+                }
+
+                // The end of the block is lost, the next one is tried.
+                this->wasted += b.size - b.offset;
+                b.offset = b.size;
+                if(this->current + 1 < this->blocks.size()){
+                    ++this->current;
+                    continue;
+                }
+            }
+
+            const size_t newSize = std::max(this->blockSize, size + alignment);
+            this->blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[newSize]), newSize, 0});
+            this->current = this->blocks.size() - 1;
+        }
+    }
+
+    /**
+     * @brief Makes all the blocks available again, without freeing them.
+     *        The objects of the arena must have been destroyed.
+     *
+     */
+    void Arena::reset(){
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        for(block &b : this->blocks)
+            b.offset = 0;
+        this->current = 0;
+        this->allocations = this->used = this->wasted = 0;
+    }
+
+    /**
+     * @brief Returns the memory used by the arena.
+     *
+     * @return arena_stats - The blocks, the objects and the bytes reserved, used and wasted.
+     */
+    Arena::arena_stats Arena::getStats() const{
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        size_t reserved = 0;
+        for(const block &b : this->blocks)
+            reserved += b.size;
+        return {this->blocks.size(), this->allocations, reserved, this->used, this->wasted};
+    }
+
+    /**
+     * @brief Returns the fraction of the memory taken by the objects that is lost between them:
+     *        to their alignment and to the ends of the blocks.
+     *
+     * @return float - The fragmentation, from 0 to 1.
+     */
+    float Arena::arena_stats::getFragmentation() const{
+        return this->used + this->wasted == 0 ? 0 : float(this->wasted) / (this->used + this->wasted);
+    }
+
+}
+}
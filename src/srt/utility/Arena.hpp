@@ -0,0 +1,109 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  ARENA CLASS HEADER                                 *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_ARENA_S
+#define S_UTILITY_ARENA_S
+
+// System includes.
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace srt{
+namespace utility{
+
+/// A monotonic arena: the objects are placed one after the other in large blocks, and they are
+/// never freed one by one. The blocks are freed all together when the arena is destroyed.
+/// The objects are created by make() as shared pointers whose control block lives in the arena too,
+/// and every control block keeps the arena alive, so an arena must be owned by a shared pointer
+/// and it is destroyed only after its last object. The allocations are thread safe.
+class Arena : public std::enable_shared_from_this<Arena>{
+public:
+    // CONSTANTS
+
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    // STRUCTURES
+
+    /// The memory of an arena: the blocks reserved, the bytes of the objects and the bytes lost to the
+    /// alignment of the objects and to the ends of the blocks too small for the next object.
+    typedef struct as{
+        size_t blocks, allocations, reserved, used, wasted;
+
+        float getFragmentation() const;
+    } arena_stats;
+
+    /// The allocator of the objects in an arena, for std::allocate_shared and the containers.
+    /// The memory is given back only when the arena is destroyed.
+    template<typename T>
+    class allocator{
+    public:
+        typedef T value_type;
+
+        std::shared_ptr<Arena> arena;
+
+        allocator(const std::shared_ptr<Arena> &arena) : arena(arena) { }
+        template<typename U>
+        allocator(const allocator<U> &other) : arena(other.arena) { }
+
+        T *allocate(const size_t n){
+            return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T *, const size_t){ }
+
+        template<typename U>
+        bool operator==(const allocator<U> &other) const{ return this->arena == other.arena; }
+        template<typename U>
+        bool operator!=(const allocator<U> &other) const{ return this->arena != other.arena; }
+    };
+
+private:
+    // STRUCTURES
+
+    typedef struct bl{
+        std::unique_ptr<unsigned char[]> data;
+        size_t size, offset;
+    } block;
+
+    // ATTRIBUTES
+
+    std::vector<block> blocks;
+    size_t current, blockSize, allocations, used, wasted;
+    mutable std::mutex mutex;
+
+public:
+    // CONSTRUCTORS
+
+    Arena(const size_t blockSize = BLOCK_SIZE);
+    Arena(const Arena &old) = delete;
+
+    // METHODS
+
+    void *allocate(const size_t size, const size_t alignment);
+    void reset();
+    arena_stats getStats() const;
+
+    /**
+     * @brief Creates an object in the arena.
+     *
+     * @param args - The arguments of the constructor of the object.
+     * @return std::shared_ptr<T> - The object, that keeps the arena alive.
+     */
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args){
+        return std::allocate_shared<T>(allocator<T>{this->shared_from_this()}, std::forward<Args>(args)...);
+    }
+};
+
+}
+}
+
+#endif
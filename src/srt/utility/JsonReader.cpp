@@ -0,0 +1,343 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  JSON READER CLASS FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "JsonReader.hpp"
+
+// System includes.
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace srt{
+namespace utility{
+
+    /**
+     * @brief Creates a reader of a text. The text is not copied, so it must outlive the reader.
+     *
+     * @param data - The text.
+     * @param size - The length of the text.
+     * @param start - The offset from which the reader starts.
+     */
+    JsonReader::JsonReader(const char *data, const size_t size, const size_t start) : 
+        begin(data), current(data + start), end(data + size), first(true) { }
+
+    /**
+     * @brief Throws an error, telling where the reader is.
+     *
+     * @param message - What is wrong.
+     */
+    void JsonReader::fail(const std::string &message) const{
+        throw std::invalid_argument("Invalid JSON at offset " + std::to_string(this->getOffset()) + ": " + message);
+    }
+
+    /**
+     * @brief Moves the reader after the white spaces.
+     *
+     */
+    void JsonReader::skipSpaces(){
+        while(this->current < this->end && (*this->current == ' ' || *this->current == '\n' ||
+                                            *this->current == '\r' || *this->current == '\t'))
+            ++this->current;
+    }
+
+    /**
+     * @brief Moves the reader after a character, that must be the next one after the spaces.
+     *
+     * @param c - The character expected.
+     */
+    void JsonReader::expect(const char c){
+        this->skipSpaces();
+        if(this->current == this->end || *this->current != c)
+            this->fail(std::string{"expected '"} + c + "'");
+        ++this->current;
+    }
+
+    /**
+     * @brief Moves the reader after a string, without decoding it.
+     *
+     */
+    void JsonReader::skipString(){
+        this->expect('"');
+        while(this->current < this->end && *this->current != '"')
+            this->current += *this->current == '\\' ? 2 : 1;
+        if(this->current >= this->end)
+            this->fail("unterminated string");
+        ++this->current;
+    }
+
+    /**
+     * @brief Returns the position of the reader.
+     *
+     * @return size_t - The offset of the next character to read from the start of the text.
+     */
+    size_t JsonReader::getOffset() const{
+        return this->current - this->begin;
+    }
+
+    /**
+     * @brief Returns the kind of the next value, without reading it.
+     *
+     * @return Token - The kind of the value, or END if the text is over.
+     */
+    JsonReader::Token JsonReader::peek(){
+        this->skipSpaces();
+        if(this->current == this->end)  return END;
+
+        switch(*this->current){
+            case '{':   return OBJECT;
+            case '[':   return ARRAY;
+            case '"':   return STRING;
+            case 't':
+            case 'f':   return BOOLEAN;
+            case 'n':   return NULL_VALUE;
+            default:    return NUMBER;
+        }
+    }
+
+    /**
+     * @brief Starts reading an object. Its members are read with nextKey().
+     *
+     */
+    void JsonReader::beginObject(){
+        this->expect('{');
+        this->first = true;
+    }
+
+    /**
+     * @brief Reads the key of the next member of the object. Its value must be read or skipped
+     *        before the next call.
+     *
+     * @param key - The key read.
+     * @return true - If a member has been read.
+     * @return false - If the object is over.
+     */
+    bool JsonReader::nextKey(std::string &key){
+        this->skipSpaces();
+        if(this->current < this->end && *this->current == '}'){
+            ++this->current;
+            this->first = false;
+            return false;
+        }
+
+        if(!this->first)    this->expect(',');
+        key = this->readString();
+        this->expect(':');
+        return true;
+    }
+
+    /**
+     * @brief Starts reading an array. Its elements are read after every call to nextElement().
+     *
+     */
+    void JsonReader::beginArray(){
+        this->expect('[');
+        this->first = true;
+    }
+
+    /**
+     * @brief Moves to the next element of the array, that must be read or skipped before the next call.
+     *
+     * @return true - If there is another element.
+     * @return false - If the array is over.
+     */
+    bool JsonReader::nextElement(){
+        this->skipSpaces();
+        if(this->current < this->end && *this->current == ']'){
+            ++this->current;
+            this->first = false;
+            return false;
+        }
+
+        if(!this->first)    this->expect(',');
+        return true;
+    }
+
+    /**
+     * @brief Reads a string, decoding its escape sequences.
+     *
+     * @return std::string - The string.
+     */
+    std::string JsonReader::readString(){
+        std::string value;
+        this->expect('"');
+
+        while(this->current < this->end && *this->current != '"'){
+            const char c = *this->current++;
+            if(c != '\\'){
+                value += c;
+                continue;
+            }
+            if(this->current == this->end)  break;
+
+            switch(*this->current++){
+                case 'b':   value += '\b';  break;
+                case 'f':   value += '\f';  break;
+                case 'n':   value += '\n';  break;
+                case 'r':   value += '\r';  break;
+                case 't':   value += '\t';  break;
+                case 'u':{
+                    unsigned int code = 0;
+                    if(this->end - this->current < 4 ||
+                       std::from_chars(this->current, this->current + 4, code, 16).ptr != this->current + 4)
+                        this->fail("invalid escape sequence");
+                    this->current += 4;
+                    // Encode the code point in UTF-8.
+                    if(code < 0x80)
+                        value += char(code);
+                    else if(code < 0x800){
+                        value += char(0xC0 | code >> 6);
+                        value += char(0x80 | (code & 0x3F));
+                    }
+                    else{
+                        value += char(0xE0 | code >> 12);
+                        value += char(0x80 | (code >> 6 & 0x3F));
+                        value += char(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default:    value += this->current[-1];
+            }
+        }
+
+        if(this->current >= this->end)
+            this->fail("unterminated string");
+        ++this->current;
+        this->first = false;
+        return value;
+    }
+
+    /**
+     * @brief Reads a number.
+     *
+     * @return float - The number.
+     */
+    float JsonReader::readNumber(){
+        this->skipSpaces();
+        float value;
+        const std::from_chars_result result = std::from_chars(this->current, this->end, value);
+        if(result.ec != std::errc{})
+            this->fail("expected a number");
+
+        this->current = result.ptr;
+        this->first = false;
+        return value;
+    }
+
+    /**
+     * @brief Reads a boolean.
+     *
+     * @return bool - The boolean.
+     */
+    bool JsonReader::readBoolean(){
+        this->skipSpaces();
+        const size_t left = this->end - this->current;
+        bool value;
+        if(left >= 4 && std::memcmp(this->current, "true", 4) == 0){
+            this->current += 4;
+            value = true;
+        }
+        else if(left >= 5 && std::memcmp(this->current, "false", 5) == 0){
+            this->current += 5;
+            value = false;
+        }
+        else
+            this->fail("expected a boolean");
+
+        this->first = false;
+        return value;
+    }
+
+    /**
+     * @brief Reads a null.
+     *
+     */
+    void JsonReader::readNull(){
+        this->skipSpaces();
+        if(this->end - this->current < 4 || std::memcmp(this->current, "null", 4) != 0)
+            this->fail("expected null");
+
+        this->current += 4;
+        this->first = false;
+    }
+
+    /**
+     * @brief Reads an array of a given number of numbers.
+     *
+     * @param values - The numbers read.
+     * @param count - The length of the array.
+     */
+    void JsonReader::readNumbers(float *values, const size_t count){
+        this->beginArray();
+        for(size_t i = 0; i < count; ++i){
+            if(!this->nextElement())
+                this->fail("expected an array of " + std::to_string(count) + " numbers");
+            values[i] = this->readNumber();
+        }
+        if(this->nextElement())
+            this->fail("expected an array of " + std::to_string(count) + " numbers");
+    }
+
+    /**
+     * @brief Reads an array of three numbers.
+     *
+     * @return geometry::Vec3 - The vector.
+     */
+    geometry::Vec3 JsonReader::readVec3(){
+        float comps[3];
+        this->readNumbers(comps, 3);
+        return {comps[0], comps[1], comps[2]};
+    }
+
+    /**
+     * @brief Skips the next value, looking only at its brackets and at its strings.
+     *
+     */
+    void JsonReader::skip(){
+        size_t depth = 0;
+        do{
+            this->skipSpaces();
+            if(this->current == this->end)
+                this->fail("unexpected end of the text");
+
+            switch(*this->current){
+                case '"':
+                    this->skipString();
+                    break;
+                case '{':
+                case '[':
+                    ++depth;
+                    ++this->current;
+                    break;
+                case '}':
+                case ']':
+                    if(depth == 0)  this->fail("unexpected end of a value");
+                    --depth;
+                    ++this->current;
+                    break;
+                case ',':
+                case ':':
+                    if(depth == 0)  this->fail("expected a value");
+                    ++this->current;
+                    break;
+                default:{
+                    // A number or a literal.
+                    const char *start = this->current;
+                    while(this->current < this->end && *this->current != '\0' &&
+                          std::strchr(",:{}[]\" \n\r\t", *this->current) == nullptr)
+                        ++this->current;
+                    if(this->current == start)  this->fail("unexpected character");
+                }
+            }
+        } while(depth > 0);
+
+        this->first = false;
+    }
+
+}
+}
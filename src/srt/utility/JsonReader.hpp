@@ -0,0 +1,73 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  JSON READER HEADER FILE                            *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_JSONREADER_S
+#define S_UTILITY_JSONREADER_S
+
+// System includes.
+#include <cstddef>
+#include <string>
+
+// My includes.
+#include "../geometry/Vec3.hpp"
+
+namespace srt{
+namespace utility{
+
+/// A streaming reader of a JSON text in memory. The values are read one at a time, in the order
+/// of the text, so the callers build their objects while they read without keeping a document.
+/// A value not needed is skipped just looking at its structure, and the offsets of the values can
+/// be used to read different parts of the same text with more readers, also in parallel.
+/// Syntax errors are reported with an std::invalid_argument that tells the offset of the error.
+class JsonReader{
+public:
+    // ENUMERATIONS
+
+    /// The kind of the next value.
+    enum Token {OBJECT, ARRAY, STRING, NUMBER, BOOLEAN, NULL_VALUE, END};
+
+private:
+    // ATTRIBUTES
+
+    const char *begin, *current, *end;
+    bool first;
+
+    // METHODS
+
+    void skipSpaces();
+    void expect(const char c);
+    void skipString();
+    [[noreturn]] void fail(const std::string &message) const;
+
+public:
+    // CONSTRUCTORS
+
+    JsonReader(const char *data, const size_t size, const size_t start = 0);
+
+    // METHODS
+
+    size_t getOffset() const;
+    Token peek();
+    void beginObject();
+    bool nextKey(std::string &key);
+    void beginArray();
+    bool nextElement();
+    std::string readString();
+    float readNumber();
+    bool readBoolean();
+    void readNull();
+    void readNumbers(float *values, const size_t count);
+    geometry::Vec3 readVec3();
+    void skip();
+};
+
+}
+}
+
+#endif
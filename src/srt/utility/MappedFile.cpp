@@ -0,0 +1,100 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MAPPED FILE CLASS FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "MappedFile.hpp"
+
+// System includes.
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace srt{
+namespace utility{
+
+    /**
+     * @brief Maps a file in memory.
+     * 
+     * @param path - The path of the file.
+     */
+    MappedFile::MappedFile(const std::string &path) : data(nullptr), size(0){
+#ifdef _WIN32
+        this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER fileSize;
+        if(this->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->file, &fileSize) || fileSize.QuadPart == 0){
+            if(this->file != INVALID_HANDLE_VALUE)  CloseHandle(this->file);
+            throw std::invalid_argument("The file " + path + " cannot be mapped");
+        }
+
+        this->size = fileSize.QuadPart;
+        this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(this->mapping != nullptr)
+            this->data = static_cast<const unsigned char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+        if(this->data == nullptr){
+            if(this->mapping != nullptr)    CloseHandle(this->mapping);
+            CloseHandle(this->file);
+            throw std::invalid_argument("The file " + path + " cannot be mapped");
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if(fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0){
+            if(fd >= 0)     close(fd);
+            throw std::invalid_argument("The file " + path + " cannot be mapped");
+        }
+
+        this->size = info.st_size;
+        void *address = mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping stays valid after the file has been closed.
+        close(fd);
+        if(address == MAP_FAILED)
+            throw std::invalid_argument("The file " + path + " cannot be mapped");
+        this->data = static_cast<const unsigned char*>(address);
+#endif
+    }
+
+    /**
+     * @brief Unmaps the file.
+     * 
+     */
+    MappedFile::~MappedFile(){
+#ifdef _WIN32
+        UnmapViewOfFile(this->data);
+        CloseHandle(this->mapping);
+        CloseHandle(this->file);
+#else
+        munmap(const_cast<unsigned char*>(this->data), this->size);
+#endif
+    }
+
+    /**
+     * @brief Returns the content of the file.
+     * 
+     * @return const unsigned char* - The first byte of the file.
+     */
+    const unsigned char *MappedFile::getData() const{
+        return this->data;
+    }
+
+    /**
+     * @brief Returns the size of the file.
+     * 
+     * @return size_t - The size in bytes.
+     */
+    size_t MappedFile::getSize() const{
+        return this->size;
+    }
+
+}
+}
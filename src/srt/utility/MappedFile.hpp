@@ -0,0 +1,47 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  MAPPED FILE CLASS HEADER                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_MAPPEDFILE_S
+#define S_UTILITY_MAPPEDFILE_S
+
+// System includes.
+#include <string>
+
+namespace srt{
+namespace utility{
+
+/// A read-only view of a whole file mapped in memory. The pages are read by the system on demand
+/// and they are shared by all the processes mapping the same file.
+class MappedFile{
+private:
+    // ATTRIBUTES
+
+    const unsigned char *data;
+    size_t size;
+#ifdef _WIN32
+    void *file, *mapping;
+#endif
+
+public:
+    // CONSTRUCTORS
+
+    MappedFile(const std::string &path);
+    MappedFile(const MappedFile &old) = delete;
+    ~MappedFile();
+
+    // METHODS
+
+    const unsigned char *getData() const;
+    size_t getSize() const;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,140 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PROFILER CLASS FILE                                *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "Profiler.hpp"
+
+// System includes.
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace srt{
+namespace utility{
+
+    // The start of the program, from which the times are measured.
+    static const std::chrono::steady_clock::time_point EPOCH = std::chrono::steady_clock::now();
+
+    std::atomic<bool> Profiler::enabled{false};
+    std::mutex Profiler::buffersMutex;
+    std::vector<std::shared_ptr<Profiler::buffer>> Profiler::buffers;
+
+    /**
+     * @brief Opens a zone, if the profiler is enabled.
+     *
+     * @param name - The name of the zone, a string literal.
+     */
+    Profiler::Zone::Zone(const char *name) : name(name), start(enabled.load(std::memory_order_relaxed) ? now() : -1) { }
+
+    /**
+     * @brief Closes the zone and records it in the buffer of the thread.
+     *
+     */
+    Profiler::Zone::~Zone(){
+        if(this->start < 0)     return;
+
+        buffer &events = getBuffer();
+        events.events[events.recorded % CAPACITY] = {this->name, this->start, now()};
+        ++events.recorded;
+    }
+
+    /**
+     * @brief Returns the current time.
+     *
+     * @return int64_t - The nanoseconds from the start of the program.
+     */
+    int64_t Profiler::now(){
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - EPOCH).count();
+    }
+
+    /**
+     * @brief Returns the buffer of the calling thread, creating it the first time.
+     *
+     * @return buffer& - The buffer.
+     */
+    Profiler::buffer &Profiler::getBuffer(){
+        thread_local buffer *events = nullptr;
+        if(events == nullptr){
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffers.push_back(std::make_shared<buffer>());
+            events = buffers.back().get();
+            events->thread = buffers.size() - 1;
+            events->recorded = 0;
+        }
+        return *events;
+    }
+
+    /**
+     * @brief Starts or stops recording the zones.
+     *
+     * @param enable - True to start, false to stop.
+     */
+    void Profiler::enable(const bool enable){
+        enabled = enable;
+    }
+
+    /**
+     * @brief Returns if the zones are being recorded.
+     *
+     * @return true - If the profiler is enabled.
+     * @return false - Otherwise.
+     */
+    bool Profiler::isEnabled(){
+        return enabled;
+    }
+
+    /**
+     * @brief Discards the zones recorded so far. No zone must be closed meanwhile.
+     *
+     */
+    void Profiler::clear(){
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for(auto &events : buffers)
+            events->recorded = 0;
+    }
+
+    /**
+     * @brief Writes the zones recorded so far as a Chrome trace. No zone must be closed meanwhile,
+     *        so it should be called when the work to profile has ended.
+     *
+     * @param path - The path of the JSON file.
+     */
+    void Profiler::write(const std::string &path){
+        std::ofstream trace(path, std::ios::out | std::ios::trunc);
+        if(!trace)
+            throw std::runtime_error("Unable to write the trace " + path + ".");
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        bool first = true;
+        const auto separator = [&](){
+            trace << (first ? "\n" : ",\n");
+            first = false;
+        };
+
+        trace << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for(const auto &events : buffers){
+            separator();
+            trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << events->thread
+                  << ",\"args\":{\"name\":\"thread " << events->thread << "\"}}";
+
+            // The oldest zone is the next to be overwritten, if the ring has been filled.
+            const size_t count = std::min(events->recorded, CAPACITY);
+            for(size_t i = events->recorded - count; i < events->recorded; ++i){
+                const event &zone = events->events[i % CAPACITY];
+                separator();
+                trace << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << events->thread
+                      << ",\"ts\":" << zone.start / 1e3 << ",\"dur\":" << (zone.end - zone.start) / 1e3 << "}";
+            }
+        }
+        trace << "\n]}\n";
+    }
+
+}
+}
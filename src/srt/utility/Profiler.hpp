@@ -0,0 +1,93 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  PROFILER CLASS HEADER                              *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_PROFILER_S
+#define S_UTILITY_PROFILER_S
+
+// System includes.
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srt{
+namespace utility{
+
+/// A profiler of the scopes of code, that records the zones opened by every thread and writes them
+/// as a Chrome trace (chrome://tracing or Perfetto), where the nested zones appear as a hierarchy.
+/// Every thread writes in its own ring buffer without locks, so the oldest zones are overwritten
+/// when a thread records more than CAPACITY of them. Nothing is recorded until the profiler is enabled.
+class Profiler{
+public:
+    // CONSTANTS
+
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    // CLASSES
+
+    /// A zone of code, recorded from its construction to its destruction. The name must be a
+    /// string literal, since only its pointer is stored.
+    class Zone{
+    private:
+        // ATTRIBUTES
+
+        const char *name;
+        int64_t start;
+
+    public:
+        // CONSTRUCTORS
+
+        Zone(const char *name);
+        Zone(const Zone &old) = delete;
+        ~Zone();
+    };
+
+private:
+    // STRUCTURES
+
+    /// A closed zone, with times in nanoseconds from the start of the program.
+    typedef struct e{
+        const char *name;
+        int64_t start, end;
+    } event;
+
+    /// The zones recorded by a thread. It is kept by the profiler after the thread ends.
+    typedef struct b{
+        uint32_t thread;
+        size_t recorded;
+        std::array<event, CAPACITY> events;
+    } buffer;
+
+    // ATTRIBUTES
+
+    static std::atomic<bool> enabled;
+    static std::mutex buffersMutex;
+    static std::vector<std::shared_ptr<buffer>> buffers;
+
+    // METHODS
+
+    static int64_t now();
+    static buffer &getBuffer();
+
+public:
+    // METHODS
+
+    static void enable(const bool enable = true);
+    static bool isEnabled();
+    static void clear();
+    static void write(const std::string &path);
+};
+
+}
+}
+
+#endif
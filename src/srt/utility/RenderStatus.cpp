@@ -0,0 +1,255 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  RENDER STATUS CLASS FILE                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "RenderStatus.hpp"
+
+// System includes.
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace srt{
+namespace utility{
+
+    // The magic number at the start of the block.
+    static const char MAGIC[4] = {'S', 'R', 'T', 'S'};
+
+    /**
+     * @brief Returns the id of the current process.
+     *
+     * @return uint64_t - The process id.
+     */
+    static uint64_t currentPid(){
+#ifdef _WIN32
+        return GetCurrentProcessId();
+#else
+        return getpid();
+#endif
+    }
+
+    /**
+     * @brief Reads the memory used by the current process.
+     *
+     * @param resident - The resident memory, in bytes.
+     * @param peak - The peak of the resident memory, in bytes.
+     */
+    static void memoryUse(uint64_t &resident, uint64_t &peak){
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        resident = counters.WorkingSetSize;
+        peak = counters.PeakWorkingSetSize;
+#else
+        // The second field of statm is the number of resident pages.
+        uint64_t pages = 0, residentPages = 0;
+        std::ifstream statm("/proc/self/statm");
+        statm >> pages >> residentPages;
+        resident = residentPages * sysconf(_SC_PAGESIZE);
+
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = uint64_t(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+    /**
+     * @brief Creates the block in shared memory and starts publishing the progress of the render.
+     *
+     * @param scene - The name of the scene rendered.
+     * @param totalTiles - The number of tiles to render.
+     * @param samplesPerTile - The samples taken to render a tile.
+     * @param period - The time between two updates of the block.
+     */
+    RenderStatus::RenderStatus(const std::string &scene, const uint64_t totalTiles, const uint64_t samplesPerTile,
+                               const std::chrono::milliseconds period) :
+        shared(nullptr), samplesPerTile(samplesPerTile), completedTiles(0), start(std::chrono::steady_clock::now()),
+        period(period), stopping(false){
+        const std::string name = getName(currentPid());
+        void *address = nullptr;
+#ifdef _WIN32
+        this->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(block), name.c_str());
+        if(this->mapping != nullptr)
+            address = MapViewOfFile(this->mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(block));
+        if(address == nullptr){
+            if(this->mapping != nullptr)    CloseHandle(this->mapping);
+            throw std::runtime_error("The status block " + name + " cannot be created");
+        }
+#else
+        const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+        if(fd < 0 || ftruncate(fd, sizeof(block)) != 0){
+            if(fd >= 0)     close(fd);
+            throw std::runtime_error("The status block " + name + " cannot be created");
+        }
+        address = mmap(nullptr, sizeof(block), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if(address == MAP_FAILED){
+            shm_unlink(name.c_str());
+            throw std::runtime_error("The status block " + name + " cannot be created");
+        }
+#endif
+
+        // The header is written as the progress, so a reader never copies half of it.
+        this->shared = new (address) block{};
+        block &status = *this->shared;
+        status.sequence.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(status.magic, MAGIC, sizeof(MAGIC));
+        status.version = VERSION;
+        status.pid = currentPid();
+        std::strncpy(status.scene, scene.c_str(), sizeof(status.scene) - 1);
+        status.totalTiles = totalTiles;
+        status.totalSamples = totalTiles * samplesPerTile;
+        status.sequence.fetch_add(1, std::memory_order_release);
+        this->publish(RUNNING);
+
+        this->publisher = std::thread(&RenderStatus::publishPeriodically, this);
+    }
+
+    /**
+     * @brief Publishes the final status, then removes the block. The readers that have already
+     *        opened it can still read the final status.
+     *
+     */
+    RenderStatus::~RenderStatus(){
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->stopRequested.notify_all();
+        this->publisher.join();
+        this->publish(DONE);
+
+#ifdef _WIN32
+        UnmapViewOfFile(this->shared);
+        CloseHandle(this->mapping);
+#else
+        munmap(this->shared, sizeof(block));
+        shm_unlink(getName(currentPid()).c_str());
+#endif
+    }
+
+    /**
+     * @brief Writes the current progress in the block.
+     *
+     * @param state - The state of the render.
+     */
+    void RenderStatus::publish(const State state){
+        const uint64_t tiles = this->completedTiles.load(std::memory_order_relaxed);
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start).count();
+        const uint64_t samples = tiles * this->samplesPerTile;
+        const double rate = elapsed > 0 ? samples / elapsed : 0;
+        uint64_t resident, peak;
+        memoryUse(resident, peak);
+
+        block &status = *this->shared;
+        status.sequence.fetch_add(1, std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_release);
+        status.state = state;
+        status.completedTiles = tiles;
+        status.completedSamples = samples;
+        status.elapsed = elapsed;
+        status.samplesPerSecond = rate;
+        status.eta = rate > 0 ? (status.totalSamples - samples) / rate : 0;
+        status.residentBytes = resident;
+        status.peakResidentBytes = peak;
+        status.sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Publishes the progress every period, until the render ends.
+     *
+     */
+    void RenderStatus::publishPeriodically(){
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while(!this->stopRequested.wait_for(lock, this->period, [this](){ return this->stopping; }))
+            this->publish(RUNNING);
+    }
+
+    /**
+     * @brief Returns the name of the block of a process.
+     *
+     * @param pid - The id of the rendering process.
+     * @return std::string - The name of the shared memory.
+     */
+    std::string RenderStatus::getName(const uint64_t pid){
+#ifdef _WIN32
+        return "Local\\srt_status_" + std::to_string(pid);
+#else
+        return "/srt_status_" + std::to_string(pid);
+#endif
+    }
+
+    /**
+     * @brief Copies the status published by a rendering process.
+     *
+     * @param pid - The id of the rendering process.
+     * @param copy - The status read.
+     * @return true - If the process publishes its status.
+     * @return false - If there is no block for that process, it is not valid or a write has not ended
+     *                 within READ_TIMEOUT, as when the process has died while writing it.
+     */
+    bool RenderStatus::read(const uint64_t pid, status &copy){
+        const std::string name = getName(pid);
+        const block *shared = nullptr;
+#ifdef _WIN32
+        void *mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+        if(mapping == nullptr)      return false;
+        shared = static_cast<const block*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(block)));
+        if(shared == nullptr){
+            CloseHandle(mapping);
+            return false;
+        }
+#else
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if(fd < 0)      return false;
+        void *address = mmap(nullptr, sizeof(block), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(address == MAP_FAILED)   return false;
+        shared = static_cast<const block*>(address);
+#endif
+
+        // The header is checked on the same copy as the progress, since it is written under the sequence too.
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + READ_TIMEOUT;
+        bool valid = false, consistent = false;
+        while(!consistent && std::chrono::steady_clock::now() < deadline){
+            const uint64_t before = shared->sequence.load(std::memory_order_acquire);
+            if(before % 2 != 0){
+                std::this_thread::yield();
+                continue;
+            }
+            valid = std::memcmp(shared->magic, MAGIC, sizeof(MAGIC)) == 0 && shared->version == VERSION;
+            copy = {shared->pid, shared->state, std::string(shared->scene, strnlen(shared->scene, sizeof(shared->scene))),
+                    shared->totalTiles, shared->completedTiles, shared->totalSamples, shared->completedSamples,
+                    shared->elapsed, shared->samplesPerSecond, shared->eta, shared->residentBytes, shared->peakResidentBytes};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            consistent = shared->sequence.load(std::memory_order_relaxed) == before;
+        }
+        valid = valid && consistent;
+
+#ifdef _WIN32
+        UnmapViewOfFile(shared);
+        CloseHandle(mapping);
+#else
+        munmap(const_cast<block*>(shared), sizeof(block));
+#endif
+        return valid;
+    }
+
+}
+}
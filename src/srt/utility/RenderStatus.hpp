@@ -0,0 +1,115 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  RENDER STATUS CLASS HEADER                         *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_RENDERSTATUS_S
+#define S_UTILITY_RENDERSTATUS_S
+
+// System includes.
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace srt{
+namespace utility{
+
+/// The progress of a render, published in a block of shared memory named after the process id
+/// (see getName), that external tools can poll while the render runs.
+/// The render only counts the completed tiles with a relaxed atomic increment: a background thread
+/// copies the counter in the block, with the rates and the memory use, every period.
+class RenderStatus{
+public:
+    // CONSTANTS
+
+    static constexpr uint32_t VERSION = 1;
+    /// How long a reader waits for a write to end, after which the writer is taken for dead.
+    static constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+
+    // ENUMERATIONS
+
+    /// The state of the render.
+    enum State : uint32_t {RUNNING, DONE};
+
+    // STRUCTURES
+
+    /// The block in shared memory. The publisher makes the sequence odd while it writes the other
+    /// fields, the header included, so a reader copies them again if the sequence is odd or changes
+    /// meanwhile.
+    typedef struct b{
+        char magic[4];
+        uint32_t version;
+        std::atomic<uint64_t> sequence;
+        uint64_t pid;
+        State state;
+        char scene[64];
+        uint64_t totalTiles, completedTiles, totalSamples, completedSamples;
+        double elapsed, samplesPerSecond, eta;
+        uint64_t residentBytes, peakResidentBytes;
+    } block;
+
+    /// A copy of the block taken by a reader.
+    typedef struct s{
+        uint64_t pid;
+        State state;
+        std::string scene;
+        uint64_t totalTiles, completedTiles, totalSamples, completedSamples;
+        double elapsed, samplesPerSecond, eta;
+        uint64_t residentBytes, peakResidentBytes;
+    } status;
+
+private:
+    // ATTRIBUTES
+
+    block *shared;
+#ifdef _WIN32
+    void *mapping;
+#endif
+    uint64_t samplesPerTile;
+    std::atomic<uint64_t> completedTiles;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::milliseconds period;
+    std::mutex mutex;
+    std::condition_variable stopRequested;
+    bool stopping;
+    std::thread publisher;
+
+    // METHODS
+
+    void publish(const State state);
+    void publishPeriodically();
+
+public:
+    // CONSTRUCTORS
+
+    RenderStatus(const std::string &scene, const uint64_t totalTiles, const uint64_t samplesPerTile,
+                 const std::chrono::milliseconds period = std::chrono::milliseconds{250});
+    RenderStatus(const RenderStatus &old) = delete;
+    ~RenderStatus();
+
+    // METHODS
+
+    /**
+     * @brief Counts a tile as completed. It is called by the render threads.
+     *
+     */
+    inline void completeTile(){
+        this->completedTiles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::string getName(const uint64_t pid);
+    static bool read(const uint64_t pid, status &copy);
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  THREAD POOL CLASS FILE                             *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "ThreadPool.hpp"
+
+namespace srt{
+namespace utility{
+
+    /**
+     * @brief Creates a new pool and starts its threads.
+     * 
+     * @param threads - The number of threads. At least one thread is always started.
+     */
+    ThreadPool::ThreadPool(const size_t threads) : running(0), stopping(false){
+        for(size_t i = 0; i < (threads > 0 ? threads : 1); ++i)
+            this->workers.emplace_back(&ThreadPool::work, this);
+    }
+
+    /**
+     * @brief Discards the tasks not yet started and joins the threads, waiting for the running tasks.
+     * 
+     */
+    ThreadPool::~ThreadPool(){
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->taskAvailable.notify_all();
+
+        for(auto &worker : this->workers)
+            worker.join();
+    }
+
+    /**
+     * @brief The loop of every thread: it waits for a task and runs it.
+     * 
+     */
+    void ThreadPool::work(){
+        while(true){
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->taskAvailable.wait(lock, [this]{ return this->stopping || !this->tasks.empty(); });
+                if(this->stopping)  return;
+
+                task = std::move(this->tasks.front());
+                this->tasks.pop();
+                ++this->running;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                --this->running;
+            }
+            this->allDone.notify_all();
+        }
+    }
+
+    /**
+     * @brief Returns the number of threads of the pool.
+     * 
+     * @return size_t - The number of threads.
+     */
+    size_t ThreadPool::getSize() const{
+        return this->workers.size();
+    }
+
+    /**
+     * @brief Adds a task to the queue of the pool.
+     * 
+     * @param task - The task to run.
+     */
+    void ThreadPool::submit(const std::function<void()> &task){
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->tasks.push(task);
+        }
+        this->taskAvailable.notify_one();
+    }
+
+    /**
+     * @brief Blocks until all the submitted tasks have been completed.
+     * 
+     */
+    void ThreadPool::wait(){
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->allDone.wait(lock, [this]{ return this->tasks.empty() && this->running == 0; });
+    }
+
+}
+}
@@ -0,0 +1,58 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  THREAD POOL CLASS HEADER                           *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_THREADPOOL_S
+#define S_UTILITY_THREADPOOL_S
+
+// System includes.
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace srt{
+namespace utility{
+
+/// A fixed set of threads that run the submitted tasks in order of submission.
+/// When the pool is destroyed, the tasks not yet started are discarded. Tasks must not throw.
+class ThreadPool{
+private:
+    // ATTRIBUTES
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable, allDone;
+    size_t running;
+    bool stopping;
+
+    // METHODS
+
+    void work();
+
+public:
+    // CONSTRUCTORS
+
+    ThreadPool(const size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &old) = delete;
+    ~ThreadPool();
+
+    // METHODS
+
+    size_t getSize() const;
+    void submit(const std::function<void()> &task);
+    void wait();
+};
+
+}
+}
+
+#endif
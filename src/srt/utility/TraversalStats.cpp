@@ -0,0 +1,61 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TRAVERSAL STATS CLASS FILE                         *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#include "TraversalStats.hpp"
+
+// System includes.
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace srt{
+namespace utility{
+
+    /**
+     * @brief Sets to zero the counters of the calling thread.
+     *
+     */
+    void TraversalStats::reset(){
+        current = {0, 0, 0};
+    }
+
+    /**
+     * @brief Writes a ppm image in which every pixel is colored from blue (cheap) to red (expensive),
+     *        relatively to the greatest value.
+     *
+     * @param path - The path of the image.
+     * @param values - The values of the pixels, row by row from the top.
+     * @param width - The width of the image.
+     * @param height - The height of the image.
+     */
+    void TraversalStats::writeHeatmap(const std::string &path, const std::vector<float> &values, const size_t width,
+                                      const size_t height){
+        if(values.size() != width * height)
+            throw std::invalid_argument("The values do not match the size of the heatmap.");
+
+        std::ofstream image(path, std::ios::out | std::ios::trunc);
+        if(!image)
+            throw std::runtime_error("Unable to write the heatmap " + path + ".");
+
+        const float maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+        const float scale = maxValue > 0 ? 1 / maxValue : 0;
+        const auto channel = [](const float t, const float center){
+            return short(255.99 * std::min(1.f, std::max(0.f, 1.5f - std::abs(4 * t - center))));
+        };
+
+        image << "P3\n" << width << ' ' << height << ' ' << "255\n";
+        for(const float value : values){
+            const float t = value * scale;
+            image << channel(t, 3) << ' ' << channel(t, 2) << ' ' << channel(t, 1) << '\n';
+        }
+    }
+
+}
+}
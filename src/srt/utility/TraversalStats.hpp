@@ -0,0 +1,59 @@
+/*******************************************************
+ *                                                     *
+ *  srt: Sushi RayTracer                               *
+ *                                                     *
+ *  TRAVERSAL STATS CLASS HEADER                       *
+ *                                                     *
+ *  Giulio Auriemma                                    *
+ *                                                     *
+ *******************************************************/
+#ifndef S_UTILITY_TRAVERSALSTATS_S
+#define S_UTILITY_TRAVERSALSTATS_S
+
+// System includes.
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The counters are updated only if the project is configured with -DTRAVERSAL_STATS=ON, otherwise
+// the macros are empty and the traversal is not touched.
+#ifdef SRT_TRAVERSAL_STATS
+#define SRT_COUNT_NODE() (++srt::utility::TraversalStats::current.nodes)
+#define SRT_COUNT_PRIMITIVES(n) (srt::utility::TraversalStats::current.primitives += (n))
+#define SRT_COUNT_BOUNCE() (++srt::utility::TraversalStats::current.bounces)
+#else
+#define SRT_COUNT_NODE()
+#define SRT_COUNT_PRIMITIVES(n)
+#define SRT_COUNT_BOUNCE()
+#endif
+
+namespace srt{
+namespace utility{
+
+/// The work done by a thread to trace its rays: the BVH nodes visited, the primitives tested and
+/// the bounces of the paths. The renderer resets the counters of the thread before a pixel and
+/// reads them after it, then the values of all the pixels can be written as heatmaps.
+class TraversalStats{
+public:
+    // STRUCTURES
+
+    /// The counters of a thread.
+    typedef struct c{
+        uint64_t nodes, primitives, bounces;
+    } counters;
+
+    // ATTRIBUTES
+
+    static inline thread_local counters current = {0, 0, 0};
+
+    // METHODS
+
+    static void reset();
+    static void writeHeatmap(const std::string &path, const std::vector<float> &values, const size_t width,
+                             const size_t height);
+};
+
+}
+}
+
+#endif